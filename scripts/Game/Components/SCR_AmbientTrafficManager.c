@@ -10,6 +10,9 @@ class GRAD_TRAFFIC_TrafficSpawnSettings
 
     [Attribute("1", desc: "Pull vehicles from the Faction Catalog?")]
     bool m_bUseCatalog;
+
+    [Attribute("1", desc: "Cache the road network analysis in the profile directory for faster restarts.")]
+    bool m_bCacheRoadAnalysis;
 }
 
 // --- Nested Group: Performance & Limits ---
@@ -24,6 +27,138 @@ class GRAD_TRAFFIC_TrafficLimitSettings
 
     [Attribute("400", desc: "Safe zone radius around players.")]
     float m_fPlayerSafeRadius;
+
+    [Attribute("5", desc: "Despawned cars kept parked for reuse instead of being deleted. 0 disables pooling.")]
+    int m_iVehiclePoolSize;
+
+    [Attribute("0", desc: "Cars created and parked in the pool after start, one per tick.")]
+    int m_iVehiclePoolWarmup;
+
+    [Attribute("600", desc: "Drivers within this distance of a player run full AI.")]
+    float m_fAIFullLODRange;
+
+    [Attribute("1500", desc: "Drivers within this distance run reduced AI; beyond it minimal AI.")]
+    float m_fAIReducedLODRange;
+
+    [Attribute("3000", desc: "Players within this distance of a car beyond the despawn range can keep it alive by looking at it.")]
+    float m_fVisibilityCheckRange;
+
+    [Attribute("0", desc: "Map-wide traffic population. Cars beyond player range drive on as cheap virtual tokens and become real vehicles when they come near a player. 0 disables virtual traffic.")]
+    int m_iVirtualTrafficCount;
+
+    [Attribute("90", desc: "Seconds a car may go without getting closer to its destination before it is re-routed, and after another such window recycled.")]
+    float m_fStuckTimeout;
+
+    [Attribute("25", desc: "Distance (m) a car must gain towards its destination within the stuck timeout to count as making progress.")]
+    float m_fStuckMinProgress;
+}
+
+// --- Nested Group: Adaptive Density ---
+[BaseContainerProps()]
+class GRAD_TRAFFIC_TrafficGovernorSettings
+{
+    [Attribute("0", desc: "Scale the vehicle cap and spawn rate with server frame time and AI load.")]
+    bool m_bAdaptiveDensity;
+
+    [Attribute("3", desc: "Lowest vehicle cap the governor may reduce to.")]
+    int m_iMinTrafficCount;
+
+    [Attribute("40", desc: "Smoothed server frame time (ms) above which the cap is lowered.")]
+    float m_fHighFrameTimeMs;
+
+    [Attribute("25", desc: "Smoothed server frame time (ms) below which the cap may rise again.")]
+    float m_fLowFrameTimeMs;
+}
+
+// --- Nested Group: Civilian Events ---
+[BaseContainerProps()]
+class GRAD_TRAFFIC_TrafficEventSettings
+{
+    [Attribute("150", desc: "Civilian events within this distance (m) of an open incident are merged into it.")]
+    float m_fIncidentRadius;
+
+    [Attribute("10", desc: "An incident closes after this many seconds without a new event; also the minimum gap between its update deliveries.")]
+    float m_fIncidentWindow;
+
+    [Attribute("1", desc: "Hook every civilian with an observer, not only traffic drivers. Off saves the hooks on missions with many placed civilians.")]
+    bool m_bObservePlacedCivilians;
+
+    [Attribute("200", desc: "Traffic cars within this distance (m) of a gunfight, panic or killed incident react together. 0 leaves reactions to each driver's own threat detection.")]
+    float m_fPanicRadius;
+
+    [Attribute("0", UIWidgets.ComboBox, desc: "How cars inside the panic radius react.", enums: ParamEnumArray.FromEnum(ETrafficPanicReaction))]
+    ETrafficPanicReaction m_ePanicReaction;
+}
+
+// --- Nested Group: Network ---
+[BaseContainerProps()]
+class GRAD_TRAFFIC_TrafficNetworkSettings
+{
+    [Attribute("0", desc: "Stream each traffic car only to clients whose player is within this distance (m). 0 leaves it to the server's network view distance.")]
+    float m_fRelevanceRadius;
+
+    [Attribute("1", desc: "Spawn traffic waypoints on the server only. Clients (and Game Master) never receive them.")]
+    bool m_bServerOnlyWaypoints;
+
+    [Attribute("0", desc: "Spawn traffic AI groups on the server only. Saves a replicated entity per car, but Game Master no longer lists traffic groups.")]
+    bool m_bServerOnlyGroups;
+
+    [Attribute("1000", desc: "Estimated replication cost of one moving car with its driver, in bytes per second per client. Used only for the bandwidth estimate in the stats.")]
+    float m_fCarBytesPerSecond;
+}
+
+// --- Nested Group: Parked Cars ---
+[BaseContainerProps()]
+class GRAD_TRAFFIC_TrafficParkingSettings
+{
+    [Attribute("0", desc: "Parking spots generated along town roads. Their cars only exist while a player is near. 0 disables parked cars.")]
+    int m_iParkedSpotCount;
+
+    [Attribute("600", desc: "Parked cars are spawned in a map cell once a player is within this distance (m) of it, and removed 200 m after the last one has left.")]
+    float m_fParkedSpawnRadius;
+}
+
+// --- Nested Group: Diagnostics ---
+[BaseContainerProps()]
+class GRAD_TRAFFIC_TrafficDiagnosticsSettings
+{
+    [Attribute("60", desc: "Seconds between aggregated [TRAFFIC STATS] log reports. 0 disables them.")]
+    int m_iStatsInterval;
+
+    [Attribute("0", desc: "Also write each report as JSON to $profile:GRAD_Traffic/stats.json.")]
+    bool m_bWriteStatsFile;
+
+    [Attribute("0", desc: "Log every spawn, waypoint and driver event. Noisy; for troubleshooting only.")]
+    bool m_bVerboseLogging;
+}
+
+// --- Nested Group: Benchmark ---
+[BaseContainerProps()]
+class GRAD_TRAFFIC_TrafficBenchmarkSettings
+{
+    [Attribute("0", desc: "Run the deterministic benchmark with synthetic observers instead of real players.")]
+    bool m_bBenchmark;
+
+    [Attribute("1234", desc: "Seed for traffic randomness and observer start points.")]
+    int m_iSeed;
+
+    [Attribute("4", desc: "Number of synthetic observers driving the road network.")]
+    int m_iSyntheticObservers;
+
+    [Attribute("15", desc: "Observer driving speed in m/s.")]
+    float m_fObserverSpeed;
+
+    [Attribute("5,10,20", desc: "Comma-separated vehicle caps; one benchmark stage is run per cap.")]
+    string m_sVehicleCaps;
+
+    [Attribute("60", desc: "Seconds per stage before measuring starts, to let traffic settle at the new cap.")]
+    int m_iWarmupSeconds;
+
+    [Attribute("300", desc: "Measured seconds per stage.")]
+    int m_iStageSeconds;
+
+    [Attribute("0", desc: "Close the game or server when the benchmark has finished.")]
+    bool m_bQuitWhenDone;
 }
 
 // --- Mod the base mission header (ACE Anvil style) ---
@@ -35,13 +170,34 @@ modded class SCR_MissionHeader
     [Attribute(desc: "Traffic limit settings")]
     ref GRAD_TRAFFIC_TrafficLimitSettings m_TrafficLimitSettings;
 
+    [Attribute(desc: "Adaptive traffic density settings")]
+    ref GRAD_TRAFFIC_TrafficGovernorSettings m_TrafficGovernorSettings;
+
+    [Attribute(desc: "Civilian event aggregation settings")]
+    ref GRAD_TRAFFIC_TrafficEventSettings m_TrafficEventSettings;
+
+    [Attribute(desc: "Traffic replication settings")]
+    ref GRAD_TRAFFIC_TrafficNetworkSettings m_TrafficNetworkSettings;
+
+    [Attribute(desc: "Parked car settings")]
+    ref GRAD_TRAFFIC_TrafficParkingSettings m_TrafficParkingSettings;
+
+    [Attribute(desc: "Traffic diagnostics settings")]
+    ref GRAD_TRAFFIC_TrafficDiagnosticsSettings m_TrafficDiagnosticsSettings;
+
+    [Attribute(desc: "Traffic benchmark settings")]
+    ref GRAD_TRAFFIC_TrafficBenchmarkSettings m_TrafficBenchmarkSettings;
+
     [Attribute("0", desc: "Display lines and markers for debugging?")]
     bool m_bShowDebugMarkers;
 }
 
 class SCR_TrafficEvents
 {
-    // Global hook: (Position, "gunfight" or "killed")
+    // Typed civilian events, raw (OnEvent) or merged into incidents (OnIncident)
+    static ref SCR_TrafficEventBus CivilianEvents = new SCR_TrafficEventBus();
+
+    // Legacy hook: (Position, "gunfight" or "killed"), still fired for every raw event
     static ref ScriptInvoker<vector, string> OnCivilianEvent = new ScriptInvoker<vector, string>();
 
     // Backwards-compatible hooks for traffic vehicle lifecycle events
@@ -49,12 +205,25 @@ class SCR_TrafficEvents
     static ref ScriptInvoker<IEntity> OnTrafficVehicleDespawned = new ScriptInvoker<IEntity>();
 }
 
+// Why an active car leaves the world; decides what becomes of it in the virtual layer
+enum ETrafficDespawnReason
+{
+    DESTROYED,     // car or driver destroyed, or the unit lost an entity
+    OUT_OF_RANGE,  // beyond the despawn range and unseen: keeps driving virtually from where it is
+    STUCK,         // recycled by the stuck monitor: the spot is bad, so no token is left on it
+    SHED           // over the cap or a cluster's share: a token here would come straight back
+}
+
 class SCR_AmbientTrafficManager
 {
     // --- Configuration ---
     protected int m_iMaxVehicles = 10;
     protected float m_fDespawnDistance = 2000;
     protected float m_fPlayerSafeRadius = 400.0;
+    protected float m_fPanicRadius = 200.0;
+    protected ETrafficPanicReaction m_ePanicReaction = ETrafficPanicReaction.FLEE;
+    protected bool m_bCacheRoadAnalysis = true;
+    protected int m_iPoolWarmupRemaining;
 
     // PREFABS - Default values that work out of the box
     protected ref array<ResourceName> m_aVehicleOptions = {
@@ -71,21 +240,256 @@ class SCR_AmbientTrafficManager
     protected ResourceName m_GroupPrefab = "{000CD338713F2B5A}Prefabs/Groups/Group_Base.et";
 
     // Tracking
-    protected ref array<Vehicle> m_aActiveVehicles = {};
-    protected ref map<Vehicle, vector> m_mVehicleDestinations = new map<Vehicle, vector>();
+    protected ref array<ref SCR_TrafficUnit> m_aActiveUnits = {};
     protected ref array<ref Shape> m_aDebugShapes = {};
 
-    // Line of Sight tracking for despawn prevention
-    protected ref map<Vehicle, float> m_mLastLOSCheck = new map<Vehicle, float>();
-    const float LOS_CHECK_INTERVAL = 3.0;
-    const float TRAFFIC_VISIBILITY_CHECK_HEIGHT = 1.5;
+    // Active units by id, bucketed by position; cells are refreshed once per tick in CleanupTraffic
+    protected ref SCR_TrafficSpatialGrid m_UnitGrid = new SCR_TrafficSpatialGrid(UNIT_GRID_CELL_SIZE);
+    protected ref map<int, SCR_TrafficUnit> m_mUnitsById = new map<int, SCR_TrafficUnit>();
+    protected ref array<int> m_aUnitQueryBuffer = {};
+    protected int m_iNextUnitId;
+
+    // Parked units waiting to be recycled
+    protected ref SCR_TrafficVehiclePool m_VehiclePool = new SCR_TrafficVehiclePool();
+
+    // Strong handles to every prefab traffic spawns
+    protected ref SCR_TrafficResourceCache m_ResourceCache = new SCR_TrafficResourceCache();
+
+    // Units being built over several frames
+    protected ref SCR_TrafficSpawnPipeline m_SpawnPipeline;
+
+    // Move waypoints for routing and flee orders, reused instead of spawned per order
+    protected ref SCR_TrafficWaypointPool m_WaypointPool;
+
+    // Load-driven vehicle cap
+    protected ref SCR_TrafficDensityGovernor m_DensityGovernor = new SCR_TrafficDensityGovernor();
+
+    // Distance-based driver AI LOD
+    protected ref SCR_TrafficDriverLOD m_DriverLOD = new SCR_TrafficDriverLOD();
+
+    // Road spawn points, sampled once at Initialize
+    protected ref SCR_TrafficRoadIndex m_RoadIndex = new SCR_TrafficRoadIndex();
+
+    // Player positions, captured once per tick and shared by every phase
+    protected ref SCR_TrafficPlayerSnapshot m_PlayerSnapshot = new SCR_TrafficPlayerSnapshot();
+
+    // Line of sight for despawn prevention, budgeted per tick
+    protected ref SCR_TrafficVisibilityService m_Visibility = new SCR_TrafficVisibilityService();
+
+    // Entity-less traffic beyond player range, created once the road index exists
+    protected ref SCR_TrafficVirtualLayer m_VirtualLayer;
+    protected int m_iVirtualTrafficCount;
+
+    // Road-snapped escape targets for panicking drivers, created once the road index exists
+    protected ref SCR_TrafficFleeRouter m_FleeRouter;
+
+    // Splits the cap between separated player clusters, created once the road index exists
+    protected ref SCR_TrafficClusterBalancer m_ClusterBalancer;
+    protected ref array<int> m_aSpawnOrder = {};
+
+    // Roadside cars in towns, spawned by cell around players
+    protected ref SCR_TrafficParkedCars m_ParkedCars;
+
+    // Which clients each car is streamed to, and the per-client load
+    protected ref SCR_TrafficRelevance m_Relevance = new SCR_TrafficRelevance();
+    protected ref array<int> m_aClientIds = {};
+    protected ref array<int> m_aClientCars = {};
+    protected bool m_bServerOnlyWaypoints = true;
+    protected bool m_bServerOnlyGroups;
+
+    // Re-routes and recycles cars that stopped making progress
+    protected ref SCR_TrafficStuckMonitor m_StuckMonitor = new SCR_TrafficStuckMonitor();
+
+    // Phase timings and counters
+    protected ref SCR_TrafficStats m_Stats = new SCR_TrafficStats();
+
+    // Set only in benchmark mode; supplies the observers instead of real players
+    protected ref SCR_TrafficBenchmark m_Benchmark;
+
     const float MIN_VEHICLE_SPACING = 200.0;
+    const float MIN_DESTINATION_DISTANCE = 2000.0;
+    const int MAX_DESTINATION_ATTEMPTS = 5;
+    const int DEFAULT_POOL_SIZE = 5;
+    const int MAX_UNITS_IN_FLIGHT = 3;
+    const float THREAT_LOD_BUMP_RADIUS = 300.0;
+    // Incidents below this severity (distant shots that only alerted someone) don't spread panic
+    const float PANIC_MIN_SEVERITY = 0.5;
+    const int MAX_PANIC_REACTIONS = 16;
+    const int UPDATE_INTERVAL_MS = 1000;
+    const float UNIT_GRID_CELL_SIZE = 250.0;
+    // Cars move between cell refreshes; widen the broad phase so a stale cell never hides one
+    const float UNIT_GRID_SLACK = 50.0;
+    const float REROUTE_SNAP_RADIUS = 150.0;
+    // Stuck cars are only recycled when no player is this close, even without line of sight
+    const float STUCK_RECYCLE_MIN_DISTANCE = 100.0;
+    // Follow-up legs: chained on arrival, kept within this share of the despawn range around the nearest player
+    const float LEG_ARRIVAL_RADIUS = 30.0;
+    const float LEG_MIN_DISTANCE = 500.0;
+    const float LEG_RING_FRACTION = 0.8;
+    const int LEG_ATTEMPTS = 12;
+
+    protected static SCR_AmbientTrafficManager s_Instance;
+    protected bool m_bRunning;
 
     // ------------------------------------------------------------------------------------------------
-    // 1. Initialization — called directly by SCR_PlayerController after game is ready
+    // 1. Initialization — called once by SCR_BaseGameMode.OnGameStart on the authority
     // ------------------------------------------------------------------------------------------------
+    static SCR_AmbientTrafficManager GetInstance()
+    {
+        return s_Instance;
+    }
+
+    SCR_TrafficResourceCache GetResourceCache()
+    {
+        return m_ResourceCache;
+    }
+
+    SCR_TrafficStats GetStats()
+    {
+        return m_Stats;
+    }
+
+    // The running manager's waypoint pool, or null when traffic is not running
+    static SCR_TrafficWaypointPool GetWaypointPool()
+    {
+        if (s_Instance && s_Instance.m_bRunning)
+            return s_Instance.m_WaypointPool;
+
+        return null;
+    }
+
+    // The running manager's flee router, or null when traffic is not running
+    static SCR_TrafficFleeRouter GetFleeRouter()
+    {
+        if (s_Instance && s_Instance.m_bRunning)
+            return s_Instance.m_FleeRouter;
+
+        return null;
+    }
+
+    // How the running manager has drivers react to incidents; FLEE when traffic is not running
+    static ETrafficPanicReaction GetPanicReaction()
+    {
+        if (s_Instance && s_Instance.m_bRunning)
+            return s_Instance.m_ePanicReaction;
+
+        return ETrafficPanicReaction.FLEE;
+    }
+
+    int GetActiveCount()
+    {
+        return m_aActiveUnits.Count();
+    }
+
+    // Replaces the configured maximum at runtime; the density governor is switched off
+    void SetVehicleCap(int cap)
+    {
+        m_iMaxVehicles = Math.Max(0, cap);
+        m_DensityGovernor.Configure(false, m_iMaxVehicles, m_iMaxVehicles, 0, 0);
+    }
+
+    // Vehicle cap currently in force (the configured maximum unless the density governor lowered it)
+    int GetEffectiveVehicleCap()
+    {
+        return m_DensityGovernor.GetEffectiveCap();
+    }
+
+    string GetDensityReason()
+    {
+        return m_DensityGovernor.GetLastReason();
+    }
+
+    // Player clusters with their car count and share of the cap, for the admin overlay
+    string GetClusterSummary()
+    {
+        if (!m_ClusterBalancer)
+            return string.Empty;
+
+        return m_ClusterBalancer.FormatSummary();
+    }
+
+    // Parked car spots and their state for the admin overlay; empty when parking is off
+    string GetParkedSummary()
+    {
+        if (!m_ParkedCars || !m_ParkedCars.IsEnabled())
+            return string.Empty;
+
+        return m_ParkedCars.FormatSummary();
+    }
+
+    // Live per-client traffic load for the admin overlay; playerId is the requesting admin
+    string GetNetworkSummary(int playerId)
+    {
+        return m_Relevance.FormatSummary(playerId);
+    }
+
+    // Slots freed by recycling cars that stopped making progress
+    int GetReclaimedSlotCount()
+    {
+        return m_StuckMonitor.GetRecycledTotal();
+    }
+
+    // Traffic vehicles within radius of pos, for mission scripts that need nearby traffic
+    void GetVehiclesNear(vector pos, float radius, notnull array<Vehicle> outVehicles)
+    {
+        array<SCR_TrafficUnit> units = {};
+        GetUnitsNear(pos, radius, units);
+
+        foreach (SCR_TrafficUnit unit : units)
+            outVehicles.Insert(unit.m_Vehicle);
+    }
+
+    bool IsAnyVehicleNear(vector pos, float radius)
+    {
+        m_aUnitQueryBuffer.Clear();
+        m_UnitGrid.Query(pos, radius + UNIT_GRID_SLACK, m_aUnitQueryBuffer);
+
+        float radiusSq = radius * radius;
+        foreach (int id : m_aUnitQueryBuffer)
+        {
+            SCR_TrafficUnit unit = m_mUnitsById.Get(id);
+            if (unit && unit.m_Vehicle && vector.DistanceSqXZ(pos, unit.m_Vehicle.GetOrigin()) < radiusSq)
+                return true;
+        }
+
+        return false;
+    }
+
+    void GetUnitsNear(vector pos, float radius, notnull array<SCR_TrafficUnit> outUnits)
+    {
+        m_aUnitQueryBuffer.Clear();
+        m_UnitGrid.Query(pos, radius + UNIT_GRID_SLACK, m_aUnitQueryBuffer);
+
+        float radiusSq = radius * radius;
+        foreach (int id : m_aUnitQueryBuffer)
+        {
+            SCR_TrafficUnit unit = m_mUnitsById.Get(id);
+            if (unit && unit.m_Vehicle && vector.DistanceSqXZ(pos, unit.m_Vehicle.GetOrigin()) < radiusSq)
+                outUnits.Insert(unit);
+        }
+    }
+
+    // Loads a prefab through the running manager's cache, or directly when traffic is not running
+    static Resource LoadPrefab(ResourceName prefab)
+    {
+        if (s_Instance && s_Instance.m_bRunning)
+            return s_Instance.m_ResourceCache.Get(prefab);
+
+        return Resource.Load(prefab);
+    }
+
+    void ~SCR_AmbientTrafficManager()
+    {
+        Shutdown();
+    }
+
     void Initialize()
     {
+        if (m_bRunning)
+            return;
+
+        s_Instance = this;
+
         // Default settings
         string factionToUse = "CIV";
         bool shouldEnable = true;
@@ -93,6 +497,10 @@ class SCR_AmbientTrafficManager
 
         // Try to load settings from mission header
         SCR_MissionHeader header = SCR_MissionHeader.Cast(GetGame().GetMissionHeader());
+
+        // Civilians report events even with traffic disabled
+        ConfigureEvents(header);
+
         if (header && header.m_TrafficSpawnSettings && header.m_TrafficLimitSettings)
         {
             Print("[TRAFFIC] Loading settings from mission header", LogLevel.NORMAL);
@@ -103,6 +511,13 @@ class SCR_AmbientTrafficManager
             m_fPlayerSafeRadius = header.m_TrafficLimitSettings.m_fPlayerSafeRadius;
             factionToUse        = header.m_TrafficSpawnSettings.m_sTargetFaction;
             useCatalog          = header.m_TrafficSpawnSettings.m_bUseCatalog;
+            m_bCacheRoadAnalysis = header.m_TrafficSpawnSettings.m_bCacheRoadAnalysis;
+            m_VehiclePool.SetCapacity(header.m_TrafficLimitSettings.m_iVehiclePoolSize);
+            m_iPoolWarmupRemaining = Math.Min(header.m_TrafficLimitSettings.m_iVehiclePoolWarmup, m_VehiclePool.GetCapacity());
+            m_DriverLOD.Configure(header.m_TrafficLimitSettings.m_fAIFullLODRange, header.m_TrafficLimitSettings.m_fAIReducedLODRange);
+            m_Visibility.SetRange(header.m_TrafficLimitSettings.m_fVisibilityCheckRange);
+            m_iVirtualTrafficCount = header.m_TrafficLimitSettings.m_iVirtualTrafficCount;
+            m_StuckMonitor.Configure(header.m_TrafficLimitSettings.m_fStuckTimeout, header.m_TrafficLimitSettings.m_fStuckMinProgress);
 
             if (!shouldEnable)
             {
@@ -113,6 +528,7 @@ class SCR_AmbientTrafficManager
         else
         {
             Print("[TRAFFIC] No mission header traffic settings found - using built-in defaults", LogLevel.NORMAL);
+            m_VehiclePool.SetCapacity(DEFAULT_POOL_SIZE);
         }
 
         if (useCatalog)
@@ -127,10 +543,239 @@ class SCR_AmbientTrafficManager
             }
         }
 
+        ConfigureGovernor(header);
+        ConfigureDiagnostics(header);
+        ConfigureNetwork(header);
+        BuildRoadIndex();
+        StartBenchmark(header);
+        m_VirtualLayer = new SCR_TrafficVirtualLayer(m_RoadIndex);
+        m_VirtualLayer.SetTargetPopulation(m_iVirtualTrafficCount);
+        m_VirtualLayer.Populate();
+        m_FleeRouter = new SCR_TrafficFleeRouter(m_RoadIndex);
+        m_ClusterBalancer = new SCR_TrafficClusterBalancer(m_RoadIndex);
+        m_ClusterBalancer.SetRange(m_fDespawnDistance);
+        PreloadPrefabs();
+        m_ParkedCars = new SCR_TrafficParkedCars(m_RoadIndex, m_ResourceCache, m_Stats);
+        ConfigureParking(header);
+        m_SpawnPipeline = new SCR_TrafficSpawnPipeline(this, m_ResourceCache, m_GroupPrefab, m_DriverPrefab);
+        m_SpawnPipeline.SetLocalGroups(m_bServerOnlyGroups);
+        m_WaypointPool = new SCR_TrafficWaypointPool(m_ResourceCache, m_WaypointPrefab);
+        m_WaypointPool.SetLocal(m_bServerOnlyWaypoints);
+
         Print(string.Format("[TRAFFIC] Initialized! %1 vehicle types | Faction: %2 | Max vehicles: %3",
             m_aVehicleOptions.Count(), factionToUse, m_iMaxVehicles), LogLevel.NORMAL);
 
-        GetGame().GetCallqueue().CallLater(UpdateTrafficLoop, 1000, true);
+        SCR_TrafficEvents.CivilianEvents.OnIncident.Insert(OnCivilianIncident);
+
+        m_bRunning = true;
+        GetGame().GetCallqueue().CallLater(UpdateTrafficLoop, UPDATE_INTERVAL_MS, true);
+    }
+
+    // Stops the loop and removes every vehicle this manager spawned. Safe to call more than once.
+    void Shutdown()
+    {
+        if (s_Instance == this)
+            s_Instance = null;
+
+        if (!m_bRunning)
+            return;
+
+        m_bRunning = false;
+
+        ScriptCallQueue queue = GetGame().GetCallqueue();
+        if (queue)
+            queue.Remove(UpdateTrafficLoop);
+
+        // Local play and listen servers run the stats overlay on this machine
+        SCR_PlayerController controller = SCR_PlayerController.Cast(GetGame().GetPlayerController());
+        if (controller)
+            controller.StopTrafficOverlay();
+
+        SCR_TrafficEvents.CivilianEvents.OnIncident.Remove(OnCivilianIncident);
+
+        if (m_SpawnPipeline)
+            m_SpawnPipeline.Clear();
+
+        foreach (SCR_TrafficUnit unit : m_aActiveUnits)
+        {
+            if (unit.m_Vehicle)
+                SCR_TrafficEvents.OnTrafficVehicleDespawned.Invoke(unit.m_Vehicle);
+
+            unit.Delete();
+        }
+
+        m_aActiveUnits.Clear();
+        if (m_WaypointPool)
+        {
+            Print(string.Format("[TRAFFIC] Waypoints: %1 spawned, %2 reused", m_WaypointPool.GetSpawnedTotal(), m_WaypointPool.GetReusedTotal()), LogLevel.NORMAL);
+            m_WaypointPool.Clear();
+        }
+
+        m_UnitGrid.Clear();
+        m_mUnitsById.Clear();
+        m_VehiclePool.Clear();
+        m_Visibility.Clear();
+
+        if (m_VirtualLayer)
+            m_VirtualLayer.Clear();
+
+        if (m_ClusterBalancer)
+            m_ClusterBalancer.Clear();
+
+        if (m_ParkedCars)
+        {
+            if (m_ParkedCars.IsEnabled())
+            {
+                Print(string.Format("[TRAFFIC] Parked cars: %1 spawned, %2 removed, %3 taken, %4 destroyed, %5 spots blocked",
+                    m_ParkedCars.GetSpawnedTotal(), m_ParkedCars.GetDespawnedTotal(), m_ParkedCars.GetTakenTotal(),
+                    m_ParkedCars.GetDestroyedTotal(), m_ParkedCars.GetBlockedTotal()), LogLevel.NORMAL);
+            }
+
+            m_ParkedCars.Clear();
+        }
+
+        if (m_FleeRouter)
+        {
+            Print(string.Format("[TRAFFIC] Flee routes: %1 lookups, %2 from cache, %3 road points cached",
+                m_FleeRouter.GetLookups(), m_FleeRouter.GetCacheHits(), m_FleeRouter.GetCachedCount()), LogLevel.NORMAL);
+            m_FleeRouter.Clear();
+        }
+
+        Print(string.Format("[TRAFFIC] Civilian events: %1 raised, merged into %2 incidents",
+            SCR_TrafficEvents.CivilianEvents.GetEventsTotal(), SCR_TrafficEvents.CivilianEvents.GetIncidentsTotal()), LogLevel.NORMAL);
+        SCR_TrafficEvents.CivilianEvents.Clear();
+
+        Print(string.Format("[TRAFFIC] Stuck cars: %1 re-routed, %2 slots reclaimed",
+            m_StuckMonitor.GetReroutesTotal(), m_StuckMonitor.GetRecycledTotal()), LogLevel.NORMAL);
+        Print(string.Format("[TRAFFIC] Prefab cache: %1 hits, %2 misses, %3 resources",
+            m_ResourceCache.GetHits(), m_ResourceCache.GetMisses(), m_ResourceCache.GetCachedCount()), LogLevel.NORMAL);
+        m_ResourceCache.Clear();
+        m_aDebugShapes.Clear();
+        m_RoadIndex.Clear();
+
+        if (m_Benchmark)
+        {
+            m_Benchmark = null;
+            SCR_TrafficRandom.Reset();
+        }
+
+        m_PlayerSnapshot.Clear();
+
+        Print("[TRAFFIC] Traffic manager shut down.", LogLevel.NORMAL);
+    }
+
+    protected void ConfigureGovernor(SCR_MissionHeader header)
+    {
+        GRAD_TRAFFIC_TrafficGovernorSettings settings;
+        if (header)
+            settings = header.m_TrafficGovernorSettings;
+
+        if (!settings || !settings.m_bAdaptiveDensity)
+        {
+            m_DensityGovernor.Configure(false, m_iMaxVehicles, m_iMaxVehicles, 0, 0);
+            return;
+        }
+
+        m_DensityGovernor.Configure(true, settings.m_iMinTrafficCount, m_iMaxVehicles, settings.m_fHighFrameTimeMs, settings.m_fLowFrameTimeMs);
+        Print(string.Format("[TRAFFIC] Adaptive density enabled: cap %1..%2, frame time %3..%4 ms",
+            settings.m_iMinTrafficCount, m_iMaxVehicles, settings.m_fLowFrameTimeMs, settings.m_fHighFrameTimeMs), LogLevel.NORMAL);
+    }
+
+    protected void ConfigureEvents(SCR_MissionHeader header)
+    {
+        if (!header || !header.m_TrafficEventSettings)
+        {
+            SCR_TrafficEvents.CivilianEvents.Configure(SCR_TrafficEventBus.DEFAULT_INCIDENT_RADIUS, SCR_TrafficEventBus.DEFAULT_INCIDENT_WINDOW);
+            return;
+        }
+
+        GRAD_TRAFFIC_TrafficEventSettings settings = header.m_TrafficEventSettings;
+        SCR_TrafficEvents.CivilianEvents.Configure(settings.m_fIncidentRadius, settings.m_fIncidentWindow);
+        m_fPanicRadius = settings.m_fPanicRadius;
+        m_ePanicReaction = settings.m_ePanicReaction;
+    }
+
+    protected void ConfigureDiagnostics(SCR_MissionHeader header)
+    {
+        GRAD_TRAFFIC_TrafficDiagnosticsSettings settings;
+        if (header)
+            settings = header.m_TrafficDiagnosticsSettings;
+
+        if (!settings)
+            return;
+
+        m_Stats.Configure(settings.m_iStatsInterval, settings.m_bWriteStatsFile);
+        SCR_TrafficLog.SetVerbose(settings.m_bVerboseLogging);
+    }
+
+    protected void ConfigureNetwork(SCR_MissionHeader header)
+    {
+        GRAD_TRAFFIC_TrafficNetworkSettings settings;
+        if (header)
+            settings = header.m_TrafficNetworkSettings;
+
+        if (!settings)
+        {
+            m_Relevance.Configure(0, 1000);
+            return;
+        }
+
+        m_Relevance.Configure(settings.m_fRelevanceRadius, settings.m_fCarBytesPerSecond);
+        m_bServerOnlyGroups = settings.m_bServerOnlyGroups;
+        // Waypoints of a server-only group are of no use to clients either
+        m_bServerOnlyWaypoints = settings.m_bServerOnlyWaypoints || m_bServerOnlyGroups;
+
+        if (m_Relevance.IsControllingStreaming())
+            Print(string.Format("[TRAFFIC] Traffic cars stream to clients within %1 m", settings.m_fRelevanceRadius), LogLevel.NORMAL);
+    }
+
+    protected void ConfigureParking(SCR_MissionHeader header)
+    {
+        if (!header || !header.m_TrafficParkingSettings || header.m_TrafficParkingSettings.m_iParkedSpotCount <= 0)
+            return;
+
+        GRAD_TRAFFIC_TrafficParkingSettings settings = header.m_TrafficParkingSettings;
+        m_ParkedCars.Configure(settings.m_fParkedSpawnRadius, m_aVehicleOptions);
+        if (!m_ParkedCars.Generate(settings.m_iParkedSpotCount))
+        {
+            Print("[TRAFFIC] No town roads found for parked cars", LogLevel.WARNING);
+            return;
+        }
+
+        Print(string.Format("[TRAFFIC] Parked cars: %1 spots along town roads", m_ParkedCars.GetSpotCount()), LogLevel.NORMAL);
+    }
+
+    // Must run before anything else draws random numbers so the seeded sequence is repeatable
+    protected void StartBenchmark(SCR_MissionHeader header)
+    {
+        if (!header || !header.m_TrafficBenchmarkSettings || !header.m_TrafficBenchmarkSettings.m_bBenchmark)
+            return;
+
+        m_Benchmark = new SCR_TrafficBenchmark(this, m_RoadIndex, header.m_TrafficBenchmarkSettings);
+        if (!m_Benchmark.Start())
+            m_Benchmark = null;
+    }
+
+    protected void PreloadPrefabs()
+    {
+        foreach (ResourceName prefab : m_aVehicleOptions)
+            m_ResourceCache.QueuePreload(prefab);
+
+        m_ResourceCache.QueuePreload(m_DriverPrefab);
+        m_ResourceCache.QueuePreload(m_GroupPrefab);
+        m_ResourceCache.QueuePreload(m_WaypointPrefab);
+        m_ResourceCache.StartPreload();
+    }
+
+    protected void BuildRoadIndex()
+    {
+        SCR_AIWorld aiWorld = SCR_AIWorld.Cast(GetGame().GetAIWorld());
+        RoadNetworkManager roadMgr;
+        if (aiWorld)
+            roadMgr = aiWorld.GetRoadNetworkManager();
+
+        if (!m_RoadIndex.Build(roadMgr, m_bCacheRoadAnalysis))
+            Print("[TRAFFIC] Road index is empty - no roads found, traffic will not spawn.", LogLevel.WARNING);
     }
 
     protected void GetVehiclesFromCatalog(string targetFactionKey, out array<ResourceName> outPrefabs)
@@ -161,8 +806,8 @@ class SCR_AmbientTrafficManager
             prefabStr.ToLower();
             if (prefabStr.Contains("helicopter") || prefabStr.Contains("plane") || prefabStr.Contains("/air/")) continue;
 
-            Resource res = Resource.Load(prefab);
-            if (!res || !res.IsValid()) continue;
+            // Validation load goes into the cache so the later preload and spawns reuse it
+            if (!m_ResourceCache.Get(prefab)) continue;
 
             outPrefabs.Insert(prefab);
         }
@@ -176,14 +821,90 @@ class SCR_AmbientTrafficManager
 
     protected void UpdateTrafficLoop()
     {
+        m_Stats.BeginPhase(ETrafficPhase.TICK);
+
+        m_Stats.BeginPhase(ETrafficPhase.SNAPSHOT);
+        if (m_Benchmark)
+            m_Benchmark.CaptureObservers(m_PlayerSnapshot, UPDATE_INTERVAL_MS / 1000.0);
+        else
+            m_PlayerSnapshot.Capture();
+        m_Stats.EndPhase(ETrafficPhase.SNAPSHOT);
+
+        m_Stats.BeginPhase(ETrafficPhase.GOVERNOR);
+        m_DensityGovernor.Update();
+        m_Stats.EndPhase(ETrafficPhase.GOVERNOR);
+
+        m_Stats.BeginPhase(ETrafficPhase.VISIBILITY);
+        m_Visibility.Process(m_PlayerSnapshot);
+        m_Stats.EndPhase(ETrafficPhase.VISIBILITY);
+        m_Stats.Count(ETrafficCounter.TRACES, m_Visibility.GetTracesLastTick());
+
+        m_Stats.BeginPhase(ETrafficPhase.WAYPOINTS);
+        m_WaypointPool.Sweep();
+        m_Stats.EndPhase(ETrafficPhase.WAYPOINTS);
+
+        m_Stats.BeginPhase(ETrafficPhase.CLEANUP);
         CleanupTraffic();
+        m_Stats.EndPhase(ETrafficPhase.CLEANUP);
+
+        m_Stats.BeginPhase(ETrafficPhase.DRIVER_LOD);
+        m_DriverLOD.Update(m_aActiveUnits, m_PlayerSnapshot);
+        m_Stats.EndPhase(ETrafficPhase.DRIVER_LOD);
 
-        if (m_aActiveVehicles.Count() < m_iMaxVehicles)
-            SpawnSingleTrafficUnit();
+        int cap = m_DensityGovernor.GetEffectiveCap();
+        int inFlight = m_SpawnPipeline.GetInFlightCount();
+
+        m_Stats.BeginPhase(ETrafficPhase.BALANCE);
+        m_ClusterBalancer.Update(m_PlayerSnapshot, m_aActiveUnits, m_SpawnPipeline, cap);
+        m_Stats.EndPhase(ETrafficPhase.BALANCE);
+
+        m_Stats.BeginPhase(ETrafficPhase.RELEVANCE);
+        m_Relevance.Update(m_PlayerSnapshot, m_aActiveUnits);
+        m_Stats.EndPhase(ETrafficPhase.RELEVANCE);
+
+        m_Stats.BeginPhase(ETrafficPhase.VIRTUAL);
+        m_VirtualLayer.Update(UPDATE_INTERVAL_MS / 1000.0, m_aActiveUnits.Count() + inFlight);
+        m_Stats.EndPhase(ETrafficPhase.VIRTUAL);
+
+        m_Stats.BeginPhase(ETrafficPhase.PARKED);
+        m_ParkedCars.Update(m_PlayerSnapshot);
+        m_Stats.EndPhase(ETrafficPhase.PARKED);
+
+        int rebalanceSource = m_ClusterBalancer.GetRebalanceSource();
+        if (m_aActiveUnits.Count() > cap)
+        {
+            ShedLeastRelevantUnit();
+        }
+        else if (m_aActiveUnits.Count() + inFlight < cap)
+        {
+            if (inFlight < MAX_UNITS_IN_FLIGHT && m_DensityGovernor.ConsumeSpawnSlot())
+                SpawnSingleTrafficUnit();
+        }
+        else if (rebalanceSource != -1)
+        {
+            // Budget is full but spent unevenly: free a slot in a cluster above its share
+            ShedLeastRelevantUnit(rebalanceSource);
+        }
+        else if (m_iPoolWarmupRemaining > 0 && inFlight == 0)
+        {
+            WarmUpPool();
+        }
 
         #ifdef WORKBENCH
         UpdateDebugLines();
         #endif
+
+        m_Stats.EndPhase(ETrafficPhase.TICK);
+        m_Stats.SetGauges(m_aActiveUnits.Count(), m_SpawnPipeline.GetInFlightCount(), m_VehiclePool.GetCount(), m_VirtualLayer.GetTokenCount(), cap);
+        m_Stats.SetWaypointGauge(m_WaypointPool.GetLiveCount());
+        m_Stats.SetParkedGauge(m_ParkedCars.GetSpawnedCount());
+        m_Relevance.GetClientLoad(m_aClientIds, m_aClientCars);
+        m_Stats.SetNetworkGauges(m_aClientIds, m_aClientCars, m_Relevance.GetBytesPerCar());
+        m_Stats.Count(ETrafficCounter.STREAM_SWITCHES, m_Relevance.ConsumeSwitches());
+        m_Stats.EndTick();
+
+        if (m_Benchmark)
+            m_Benchmark.OnTick();
     }
 
     protected void SpawnSingleTrafficUnit()
@@ -194,17 +915,37 @@ class SCR_AmbientTrafficManager
             return;
         }
 
-        vector spawnPos, destPos;
-        if (!FindValidRoadPoints(spawnPos, destPos))
+        // With virtual traffic, cars only appear where a token drives into the player ring
+        m_Stats.Count(ETrafficCounter.SPAWN_ATTEMPTS);
+        m_Stats.BeginPhase(ETrafficPhase.ROAD_QUERY);
+
+        // Players of the clusters furthest below their share are searched first
+        m_aSpawnOrder.Clear();
+        m_ClusterBalancer.GetSpawnOrder(m_aSpawnOrder);
+
+        vector spawnPos, destPos, forward;
+        bool found;
+        if (m_VirtualLayer.IsEnabled())
+            found = FindVirtualSpawn(spawnPos, destPos, forward);
+        else
+            found = FindValidRoadPoints(spawnPos, destPos, forward);
+
+        m_Stats.EndPhase(ETrafficPhase.ROAD_QUERY);
+
+        if (!found)
         {
-            Print("[TRAFFIC DEBUG] Failed to find road points. Retrying next loop.", LogLevel.WARNING);
+            m_Stats.Count(ETrafficCounter.SPAWN_SEARCH_FAILURES);
+            if (SCR_TrafficLog.IsVerbose())
+                Print("[TRAFFIC DEBUG] Failed to find road points. Retrying next loop.", LogLevel.WARNING);
+
             return;
         }
 
+        m_ClusterBalancer.OnSpawned(m_PlayerSnapshot, spawnPos);
+
         EntitySpawnParams params = new EntitySpawnParams();
         params.TransformMode = ETransformMode.WORLD;
 
-        vector forward = vector.Direction(spawnPos, destPos);
         if (forward.LengthSq() < 0.0001)
             forward = "0 0 1";
 
@@ -212,150 +953,133 @@ class SCR_AmbientTrafficManager
         Math3D.DirectionAndUpMatrix(forward, up, params.Transform);
         params.Transform[3] = spawnPos;
 
-        // 1. Spawn Group
-        IEntity groupEnt = GetGame().SpawnEntityPrefab(Resource.Load(m_GroupPrefab), GetGame().GetWorld(), params);
-        SCR_AIGroup group = SCR_AIGroup.Cast(groupEnt);
-        if (!group)
+        // Recycle a parked unit when available; it is ready to drive right away
+        SCR_TrafficUnit unit = m_VehiclePool.Take();
+        if (unit)
         {
-            Print("[TRAFFIC ERROR] Failed to spawn AIGroup!", LogLevel.ERROR);
+            m_VehiclePool.Unpark(unit, params);
+            unit.m_vDestination = destPos;
+            ActivateUnit(unit);
+            m_Stats.Count(ETrafficCounter.RECYCLED);
+            if (SCR_TrafficLog.IsVerbose())
+                Print(string.Format("[TRAFFIC] Recycled %1 at %2 (Heading to %3)", unit.m_Vehicle.GetName(), spawnPos, destPos), LogLevel.NORMAL);
+
             return;
         }
 
-        FactionManager factionMgr = GetGame().GetFactionManager();
-        if (factionMgr)
+        // Otherwise build a new one over the next frames
+        SCR_TrafficSpawnJob job = new SCR_TrafficSpawnJob();
+        job.m_Params = params;
+        job.m_VehiclePrefab = m_aVehicleOptions[SCR_TrafficRandom.RandomInt(0, m_aVehicleOptions.Count())];
+        job.m_Unit.m_vDestination = destPos;
+        m_SpawnPipeline.Enqueue(job);
+    }
+
+    // Called by the spawn pipeline when a job is done or has given up
+    void OnSpawnJobFinished(SCR_TrafficSpawnJob job, bool success)
+    {
+        if (!success || !m_bRunning)
         {
-            Faction civFaction = factionMgr.GetFactionByKey("CIV");
-            if (civFaction)
-                group.SetFaction(civFaction);
+            if (success)
+                job.m_Unit.Delete();
             else
-                Print("[TRAFFIC ERROR] CIV Faction not found in FactionManager!", LogLevel.ERROR);
-        }
+                m_Stats.Count(ETrafficCounter.SPAWN_JOB_FAILURES);
 
-        // 2. Spawn Vehicle
-        ResourceName randomCarPath = m_aVehicleOptions.GetRandomElement();
-        IEntity vehEnt = GetGame().SpawnEntityPrefab(Resource.Load(randomCarPath), GetGame().GetWorld(), params);
-        Vehicle vehicle = Vehicle.Cast(vehEnt);
-        if (!vehicle)
-        {
-            Print("[TRAFFIC ERROR] Failed to spawn Vehicle entity!", LogLevel.ERROR);
-            SCR_EntityHelper.DeleteEntityAndChildren(group);
             return;
         }
 
-        m_aActiveVehicles.Insert(vehicle);
-        m_mVehicleDestinations.Insert(vehicle, destPos);
-
-        SCR_TrafficEvents.OnTrafficVehicleSpawned.Invoke(vehicle);
-
-        // 3. Spawn Driver
-        IEntity drvEnt = GetGame().SpawnEntityPrefab(Resource.Load(m_DriverPrefab), GetGame().GetWorld(), params);
-        if (!drvEnt)
+        SCR_TrafficUnit unit = job.m_Unit;
+        if (job.m_bParkWhenReady)
         {
-            Print("[TRAFFIC ERROR] Failed to spawn Driver entity!", LogLevel.ERROR);
-            SCR_EntityHelper.DeleteEntityAndChildren(group);
-            SCR_EntityHelper.DeleteEntityAndChildren(vehicle);
+            if (!m_VehiclePool.Park(unit))
+                unit.Delete();
+
             return;
         }
 
-        // 4. Link Agent to Group
-        AIControlComponent aiControl = AIControlComponent.Cast(drvEnt.FindComponent(AIControlComponent));
-        if (aiControl)
-        {
-            AIAgent agent = aiControl.GetControlAIAgent();
-            if (agent)
-            {
-                agent.PreventMaxLOD();
-                group.AddAgent(agent);
-                Print(string.Format("[TRAFFIC DEBUG] Agent %1 added to Group %2", agent, group), LogLevel.NORMAL);
-            }
-            else
-            {
-                Print("[TRAFFIC ERROR] Driver has AIControl but no AIAgent!", LogLevel.ERROR);
-            }
-        }
-        else
-        {
-            Print("[TRAFFIC ERROR] Driver prefab missing AIControlComponent!", LogLevel.ERROR);
-        }
+        ActivateUnit(unit);
+        m_Stats.Count(ETrafficCounter.SPAWNED);
+        if (SCR_TrafficLog.IsVerbose())
+            Print(string.Format("[TRAFFIC] Spawned %1 at %2 (Heading to %3)", unit.m_Vehicle.GetName(), job.GetPosition(), unit.m_vDestination), LogLevel.NORMAL);
+    }
 
-        SCR_AIGroupUtilityComponent utility = SCR_AIGroupUtilityComponent.Cast(group.FindComponent(SCR_AIGroupUtilityComponent));
-        if (utility)
-            utility.SetCombatMode(EAIGroupCombatMode.HOLD_FIRE);
+    // A seated, AI-active unit joins the active set and starts driving
+    protected void ActivateUnit(SCR_TrafficUnit unit)
+    {
+        m_aActiveUnits.Insert(unit);
+        IndexUnit(unit);
+        m_StuckMonitor.ResetReroutes(unit);
+        m_StuckMonitor.Track(unit, unit.m_Vehicle.GetOrigin());
 
-        // 5. Seat Driver
-        if (MoveDriverInVehicle(vehicle, drvEnt))
-            Print("[TRAFFIC DEBUG] Driver seated in Pilot seat successfully.", LogLevel.NORMAL);
-        else
-            Print("[TRAFFIC ERROR] Failed to seat driver! Check CompartmentAccessComponent.", LogLevel.ERROR);
+        SCR_TrafficEvents.OnTrafficVehicleSpawned.Invoke(unit.m_Vehicle);
 
-        if (aiControl)
+        ForceVehicleStart(unit.m_Vehicle);
+        AssignUnitWaypoint(unit);
+    }
+
+    // Queues one unit at the parking position so the pool is warm before it is needed
+    protected void WarmUpPool()
+    {
+        if (m_aVehicleOptions.IsEmpty() || !m_VehiclePool.HasRoom())
         {
-            AIAgent agent = aiControl.GetControlAIAgent();
-            if (agent)
-            {
-                agent.DeactivateAI();
-                agent.ActivateAI();
-            }
+            m_iPoolWarmupRemaining = 0;
+            return;
         }
 
-        ForceVehicleStart(vehicle);
-
-        // 6. Assign Waypoint
-        GetGame().GetCallqueue().CallLater(DelayedWaypointAssign, 2000, false, group, destPos);
+        m_iPoolWarmupRemaining--;
 
-        Print(string.Format("[TRAFFIC] Spawned %1 at %2 (Heading to %3)", vehicle.GetName(), spawnPos, destPos), LogLevel.NORMAL);
+        EntitySpawnParams params = new EntitySpawnParams();
+        params.TransformMode = ETransformMode.WORLD;
+        Math3D.MatrixIdentity4(params.Transform);
+        params.Transform[3] = m_VehiclePool.GetStagingPosition();
+
+        SCR_TrafficSpawnJob job = new SCR_TrafficSpawnJob();
+        job.m_Params = params;
+        job.m_VehiclePrefab = m_aVehicleOptions[SCR_TrafficRandom.RandomInt(0, m_aVehicleOptions.Count())];
+        job.m_bParkWhenReady = true;
+        m_SpawnPipeline.Enqueue(job);
     }
 
     protected void UpdateDebugLines()
     {
         m_aDebugShapes.Clear();
 
-        foreach (Vehicle veh, vector dest : m_mVehicleDestinations)
+        foreach (SCR_TrafficUnit unit : m_aActiveUnits)
         {
-            if (!veh) continue;
+            if (!unit.m_Vehicle) continue;
 
             vector points[2];
-            points[0] = veh.GetOrigin();
-            points[1] = dest;
+            points[0] = unit.m_Vehicle.GetOrigin();
+            points[1] = unit.m_vDestination;
 
             m_aDebugShapes.Insert(Shape.CreateLines(Color.CYAN, ShapeFlags.NOZBUFFER | ShapeFlags.TRANSP, points, 2));
         }
     }
 
-    protected void DelayedWaypointAssign(SCR_AIGroup group, vector pos)
+    protected void AssignUnitWaypoint(SCR_TrafficUnit unit)
     {
-        if (!group)
-        {
-            Print("[TRAFFIC DEBUG] DelayedWaypointAssign failed: Group is null (despawned?)", LogLevel.WARNING);
-            return;
-        }
+        SCR_AIGroup group = unit.m_Group;
+        vector pos = unit.m_vDestination;
 
         int agentCount = group.GetAgentsCount();
         if (agentCount == 0)
         {
-            Print("[TRAFFIC DEBUG] DelayedWaypointAssign failed: Group is empty (no agents)!", LogLevel.WARNING);
+            Print("[TRAFFIC DEBUG] AssignUnitWaypoint failed: Group is empty (no agents)!", LogLevel.WARNING);
             return;
         }
 
-        Print(string.Format("[TRAFFIC DEBUG] Assigning waypoint to Group (Agents: %1) at Dest: %2", agentCount, pos), LogLevel.NORMAL);
-        CreateWaypointForGroup(group, pos);
+        if (SCR_TrafficLog.IsVerbose())
+            Print(string.Format("[TRAFFIC DEBUG] Assigning waypoint to Group (Agents: %1) at Dest: %2", agentCount, pos), LogLevel.NORMAL);
+
+        // Not timed here: this runs inside CLEANUP and SPAWN_STAGES, which already count it
+        CreateWaypointForGroup(group, pos, true);
+        m_Stats.Count(ETrafficCounter.WAYPOINTS);
 
         AIWaypoint currentWp = group.GetCurrentWaypoint();
-        if (currentWp)
-            Print(string.Format("[TRAFFIC] Group %1 has waypoint %2", group, currentWp), LogLevel.NORMAL);
-        else
+        if (!currentWp)
             Print(string.Format("[TRAFFIC ERROR] Group %1 has NO waypoint after assignment!", group), LogLevel.ERROR);
-
-        array<AIAgent> agents = {};
-        group.GetAgents(agents);
-        foreach (AIAgent agent : agents)
-        {
-            SCR_ChimeraCharacter char = SCR_ChimeraCharacter.Cast(agent.GetControlledEntity());
-            if (char && char.IsInVehicle())
-                Print("[TRAFFIC] Agent is physically inside vehicle.", LogLevel.NORMAL);
-            else
-                Print("[TRAFFIC ERROR] Agent is NOT in vehicle physics!", LogLevel.ERROR);
-        }
+        else if (SCR_TrafficLog.IsVerbose())
+            Print(string.Format("[TRAFFIC] Group %1 has waypoint %2", group, currentWp), LogLevel.NORMAL);
     }
 
     void ForceVehicleStart(Vehicle vehicle)
@@ -365,40 +1089,42 @@ class SCR_AmbientTrafficManager
         {
             carController.StartEngine();
             carController.SetPersistentHandBrake(false);
-            Print(string.Format("[TRAFFIC] Hotwired vehicle %1", vehicle), LogLevel.NORMAL);
+            if (SCR_TrafficLog.IsVerbose())
+                Print(string.Format("[TRAFFIC] Hotwired vehicle %1", vehicle), LogLevel.NORMAL);
         }
     }
 
-    protected void CreateWaypointForGroup(SCR_AIGroup group, vector destPos)
+    // destKnownReachable: destPos came from the road index on the group's own component,
+    // so the reachability query can be skipped.
+    protected void CreateWaypointForGroup(SCR_AIGroup group, vector destPos, bool destKnownReachable = false)
     {
-        SCR_AIWorld aiWorld = SCR_AIWorld.Cast(GetGame().GetAIWorld());
-        RoadNetworkManager roadMgr = aiWorld.GetRoadNetworkManager();
-
-        vector reachablePos;
+        vector reachablePos = destPos;
         float radius = 20.0;
 
-        if (!roadMgr.GetReachableWaypointInRoad(group.GetOrigin(), destPos, radius, reachablePos))
-            reachablePos = destPos;
+        if (!destKnownReachable)
+        {
+            SCR_AIWorld aiWorld = SCR_AIWorld.Cast(GetGame().GetAIWorld());
+            RoadNetworkManager roadMgr;
+            if (aiWorld)
+                roadMgr = aiWorld.GetRoadNetworkManager();
 
-        EntitySpawnParams params = new EntitySpawnParams();
-        params.Transform[3] = reachablePos;
+            if (!roadMgr || !roadMgr.GetReachableWaypointInRoad(group.GetOrigin(), destPos, radius, reachablePos))
+                reachablePos = destPos;
+        }
 
-        IEntity wpEnt = GetGame().SpawnEntityPrefab(Resource.Load(m_WaypointPrefab), GetGame().GetWorld(), params);
-        AIWaypoint wp = AIWaypoint.Cast(wpEnt);
+        float distShift = vector.Distance(reachablePos, destPos);
+        AIWaypoint wp = m_WaypointPool.Assign(group, reachablePos, Math.Max(5.0, radius - distShift));
 
         if (wp)
         {
-            float distShift = vector.Distance(reachablePos, destPos);
-            wp.SetCompletionRadius(Math.Max(5.0, radius - distShift));
-            group.AddWaypoint(wp);
-
             #ifdef WORKBENCH
             vector points[2];
             points[0] = group.GetOrigin();
             points[1] = reachablePos;
             Shape debugLine = Shape.CreateLines(Color.RED, ShapeFlags.NOZBUFFER | ShapeFlags.TRANSP, points, 2);
             m_aDebugShapes.Insert(debugLine);
-            Print("DEBUG: Spawned shape at " + reachablePos.ToString(), LogLevel.NORMAL);
+            if (SCR_TrafficLog.IsVerbose())
+                Print("DEBUG: Spawned shape at " + reachablePos.ToString(), LogLevel.NORMAL);
             #endif
 
             SCR_MissionHeader header = SCR_MissionHeader.Cast(GetGame().GetMissionHeader());
@@ -408,15 +1134,6 @@ class SCR_AmbientTrafficManager
                 if (mapEnt)
                     Print(string.Format("[TRAFFIC DEBUG] Path: %1 -> %2", group.GetOrigin(), reachablePos), LogLevel.NORMAL);
             }
-
-            SCR_EditableEntityComponent editable = SCR_EditableEntityComponent.Cast(wpEnt.FindComponent(SCR_EditableEntityComponent));
-            if (editable)
-                editable.SetParentEntity(null);
-
-            SCR_EditableEntityComponent groupEditable = SCR_EditableEntityComponent.Cast(group.FindComponent(SCR_EditableEntityComponent));
-            SCR_EditableEntityComponent wpEditable = SCR_EditableEntityComponent.Cast(wpEnt.FindComponent(SCR_EditableEntityComponent));
-            if (groupEditable && wpEditable)
-                wpEditable.SetParentEntity(groupEditable);
         }
     }
 
@@ -426,297 +1143,448 @@ class SCR_AmbientTrafficManager
     protected void CleanupTraffic()
     {
         array<int> indicesToDelete = {};
-        array<int> playerIds = {};
-        GetGame().GetPlayerManager().GetPlayers(playerIds);
 
-        for (int i = 0; i < m_aActiveVehicles.Count(); i++)
+        for (int i = 0; i < m_aActiveUnits.Count(); i++)
         {
-            Vehicle veh = m_aActiveVehicles[i];
-            if (!veh) { indicesToDelete.Insert(i); continue; }
+            SCR_TrafficUnit unit = m_aActiveUnits[i];
+            Vehicle veh = unit.m_Vehicle;
+            if (!veh) { UnindexUnit(unit); unit.Delete(); indicesToDelete.Insert(i); continue; }
 
-            DamageManagerComponent damage = DamageManagerComponent.Cast(veh.FindComponent(DamageManagerComponent));
-            if (damage && damage.GetState() == EDamageState.DESTROYED)
+            if (unit.IsVehicleDestroyed())
             {
-                CleanupVehicle(veh);
+                DespawnUnit(unit, ETrafficDespawnReason.DESTROYED);
                 indicesToDelete.Insert(i);
                 continue;
             }
 
             vector vehPos = veh.GetOrigin();
-            bool isPlayerNearby = false;
-
-            foreach (int playerId : playerIds)
+            unit.m_iCellKey = m_UnitGrid.Move(unit.m_iCellKey, vehPos, unit.m_iId);
+            if (m_PlayerSnapshot.IsAnyPlayerWithin(vehPos, m_fDespawnDistance))
             {
-                IEntity player = GetGame().GetPlayerManager().GetPlayerControlledEntity(playerId);
-                if (!player) continue;
-
-                if (vector.Distance(vehPos, player.GetOrigin()) < m_fPlayerSafeRadius)
+                // A stopped or fleeing driver keeps its reaction: no leg chaining (it would release the
+                // handbrake) and no stuck verdicts. The progress window restarts every tick so it opens
+                // fresh once the panic ends.
+                if (unit.IsPanicked())
                 {
-                    isPlayerNearby = true;
-                    break;
+                    m_StuckMonitor.Track(unit, vehPos);
+                    continue;
                 }
+
+                if (IsLegComplete(unit, vehPos))
+                    ChainNextLeg(unit, vehPos);
+
+                if (HandleProgress(unit, vehPos))
+                    indicesToDelete.Insert(i);
+
+                continue;
             }
 
-            if (!isPlayerNearby)
+            // No fresh visibility result yet: a check is queued, keep the car until it comes back
+            bool visible;
+            if (!m_Visibility.GetVisibility(unit, visible))
+                continue;
+
+            if (visible)
             {
-                float minPlayerDist = float.MAX;
-                foreach (int pId : playerIds)
-                {
-                    IEntity player = GetGame().GetPlayerManager().GetPlayerControlledEntity(pId);
-                    if (player)
-                    {
-                        float dist = vector.Distance(vehPos, player.GetOrigin());
-                        if (dist < minPlayerDist) minPlayerDist = dist;
-                    }
-                }
+                Print("[TRAFFIC] Vehicle beyond despawn range but visible, keeping", LogLevel.DEBUG);
+                continue;
+            }
 
-                if (minPlayerDist > m_fDespawnDistance)
-                {
-                    if (IsVehicleVisibleToAnyPlayer(veh))
-                    {
-                        Print(string.Format("[TRAFFIC] Vehicle beyond despawn range but visible, keeping (distance: %.0fm)", minPlayerDist), LogLevel.DEBUG);
-                        continue;
-                    }
+            DespawnUnit(unit, ETrafficDespawnReason.OUT_OF_RANGE);
+            indicesToDelete.Insert(i);
+            Print(string.Format("[TRAFFIC] Despawned vehicle at %1 (beyond %2m, not visible)", vehPos, m_fDespawnDistance), LogLevel.DEBUG);
+        }
 
-                    CleanupVehicle(veh);
-                    indicesToDelete.Insert(i);
-                    Print(string.Format("[TRAFFIC] Despawned vehicle (distance: %.0fm, not visible)", minPlayerDist), LogLevel.DEBUG);
-                }
+        for (int i = indicesToDelete.Count() - 1; i >= 0; i--)
+            m_aActiveUnits.Remove(indicesToDelete[i]);
+    }
+
+    // Applies the stuck monitor's verdict. Returns true when the unit was recycled.
+    protected bool HandleProgress(SCR_TrafficUnit unit, vector vehPos)
+    {
+        ETrafficProgressVerdict verdict = m_StuckMonitor.Evaluate(unit, vehPos);
+        if (verdict == ETrafficProgressVerdict.OK)
+            return false;
+
+        if (verdict == ETrafficProgressVerdict.REROUTE)
+        {
+            if (RerouteUnit(unit, vehPos))
+            {
+                m_StuckMonitor.RecordReroute(unit, vehPos);
+                Print(string.Format("[TRAFFIC] Vehicle at %1 made no progress, re-routed to %2", vehPos, unit.m_vDestination), LogLevel.DEBUG);
+                return false;
             }
+
+            m_StuckMonitor.MarkStuck(unit);
         }
 
-        for (int i = indicesToDelete.Count() - 1; i >= 0; i--)
-            m_aActiveVehicles.Remove(indicesToDelete[i]);
+        // Recycle only out of sight; until then the flag stays set and this is retried every tick
+        if (m_PlayerSnapshot.IsAnyPlayerWithin(vehPos, STUCK_RECYCLE_MIN_DISTANCE))
+            return false;
+
+        bool visible;
+        if (!m_Visibility.GetVisibility(unit, visible) || visible)
+            return false;
+
+        DespawnUnit(unit, ETrafficDespawnReason.STUCK);
+        m_StuckMonitor.RecordRecycled();
+        if (SCR_TrafficLog.IsVerbose())
+            Print(string.Format("[TRAFFIC] Recycled stuck vehicle at %1 (%2 slots reclaimed)", vehPos, m_StuckMonitor.GetRecycledTotal()), LogLevel.NORMAL);
+        return true;
+    }
+
+    // New destination from the road point nearest to the car; fails when the driver is no longer seated
+    protected bool RerouteUnit(SCR_TrafficUnit unit, vector vehPos)
+    {
+        ChimeraCharacter driver = ChimeraCharacter.Cast(unit.m_Driver);
+        if (!driver || !driver.IsInVehicle() || !unit.GetAgent())
+            return false;
+
+        int point = m_RoadIndex.FindNearestPoint(vehPos, REROUTE_SNAP_RADIUS);
+        if (point == -1)
+            return false;
+
+        int destPoint = m_RoadIndex.PickDestination(point, MIN_DESTINATION_DISTANCE, MAX_DESTINATION_ATTEMPTS);
+        if (destPoint == -1)
+            return false;
+
+        SendUnitTo(unit, destPoint);
+        return true;
+    }
+
+    // The group has no waypoint left (arrived, or a flee order ran out) or the car is at its destination
+    protected bool IsLegComplete(SCR_TrafficUnit unit, vector vehPos)
+    {
+        if (!unit.m_Group)
+            return false;
+
+        return !unit.m_Group.GetCurrentWaypoint() || vector.DistanceSqXZ(vehPos, unit.m_vDestination) < LEG_ARRIVAL_RADIUS * LEG_ARRIVAL_RADIUS;
+    }
+
+    // Keeps an arrived car driving: the next destination is a road point on the same component that
+    // stays inside the ring around the nearest player, so the car remains useful traffic there
+    // instead of idling until it is despawned and replaced.
+    protected bool ChainNextLeg(SCR_TrafficUnit unit, vector vehPos)
+    {
+        int player = m_PlayerSnapshot.GetNearestPlayerIndex(vehPos, m_fDespawnDistance);
+        if (player == -1)
+            return false;
+
+        int point = m_RoadIndex.FindNearestPoint(vehPos, REROUTE_SNAP_RADIUS);
+        if (point == -1)
+            return false;
+
+        int destPoint = m_RoadIndex.PickDestinationWithin(point, m_PlayerSnapshot.GetPosition(player), m_fDespawnDistance * LEG_RING_FRACTION, LEG_MIN_DISTANCE, LEG_ATTEMPTS);
+        if (destPoint == -1)
+            return false;
+
+        SendUnitTo(unit, destPoint);
+        m_StuckMonitor.ResetReroutes(unit);
+        m_StuckMonitor.Track(unit, vehPos);
+        m_Stats.Count(ETrafficCounter.LEGS);
+
+        if (SCR_TrafficLog.IsVerbose())
+            Print(string.Format("[TRAFFIC] Vehicle at %1 chained next leg to %2", vehPos, unit.m_vDestination), LogLevel.NORMAL);
+
+        return true;
+    }
+
+    protected void SendUnitTo(SCR_TrafficUnit unit, int destPoint)
+    {
+        unit.ClearWaypoints();
+        unit.m_vDestination = m_RoadIndex.GetPosition(destPoint);
+        ForceVehicleStart(unit.m_Vehicle);
+        AssignUnitWaypoint(unit);
+    }
+
+    // Over the cap: remove the unit farthest from any player, one per tick. Units inside the
+    // safe radius or in someone's view are kept so nothing vanishes in front of a player.
+    // With a cluster given, only that cluster's units are considered.
+    protected void ShedLeastRelevantUnit(int cluster = -1)
+    {
+        int shedIndex = -1;
+        float farthest = m_fPlayerSafeRadius;
+
+        foreach (int i, SCR_TrafficUnit unit : m_aActiveUnits)
+        {
+            if (!unit.m_Vehicle) continue;
+            if (cluster != -1 && unit.m_iCluster != cluster) continue;
+
+            float dist = m_PlayerSnapshot.GetNearestPlayerDistance(unit.m_Vehicle.GetOrigin(), m_fDespawnDistance);
+            if (dist > farthest)
+            {
+                farthest = dist;
+                shedIndex = i;
+            }
+        }
+
+        if (shedIndex == -1)
+            return;
+
+        // Only the chosen unit is checked; if it is seen (or not checked yet), try again next tick
+        bool visible;
+        if (!m_Visibility.GetVisibility(m_aActiveUnits[shedIndex], visible) || visible)
+            return;
+
+        DespawnUnit(m_aActiveUnits[shedIndex], ETrafficDespawnReason.SHED);
+        m_aActiveUnits.Remove(shedIndex);
+        Print(string.Format("[TRAFFIC] Shed vehicle %1m from nearest player (cap %2)", Math.Round(farthest), m_DensityGovernor.GetEffectiveCap()), LogLevel.DEBUG);
     }
 
     // ------------------------------------------------------------------------------------------------
     // 4. Helpers
     // ------------------------------------------------------------------------------------------------
-    protected bool FindValidRoadPoints(out vector spawn, out vector dest)
+    // Picks a spawn from the road index inside the ring [m_fPlayerSafeRadius, m_fDespawnDistance]
+    // around the players in m_aSpawnOrder, then a destination from the same road component. outHeading follows the road,
+    // flipped so the car faces its destination.
+    protected bool FindValidRoadPoints(out vector spawn, out vector dest, out vector outHeading)
     {
-        SCR_AIWorld aiWorld = SCR_AIWorld.Cast(GetGame().GetAIWorld());
-        if (!aiWorld) return false;
+        if (!m_RoadIndex.IsBuilt()) return false;
 
-        RoadNetworkManager roadMgr = aiWorld.GetRoadNetworkManager();
-        if (!roadMgr) return false;
+        if (m_aSpawnOrder.IsEmpty()) return false;
 
-        array<int> playerIds = {};
-        GetGame().GetPlayerManager().GetPlayers(playerIds);
-        array<vector> playerPositions = {};
-        foreach (int playerId : playerIds)
-        {
-            IEntity player = GetGame().GetPlayerManager().GetPlayerControlledEntity(playerId);
-            if (player)
-                playerPositions.Insert(player.GetOrigin());
-        }
+        int spawnPoint = -1;
+        array<int> candidates = {};
 
-        for (int i = 0; i < 15; i++)
+        foreach (int player : m_aSpawnOrder)
         {
-            vector sPos = GetRandomMapPos();
-            BaseRoad r1;
-            float dist1;
-            if (roadMgr.GetClosestRoad(sPos, r1, dist1) == -1) continue;
+            if (spawnPoint != -1) break;
 
-            array<vector> p1 = {};
-            r1.GetPoints(p1);
-            spawn = p1[0];
+            candidates.Clear();
+            m_RoadIndex.QueryRing(m_PlayerSnapshot.GetPosition(player), m_fPlayerSafeRadius, m_fDespawnDistance, candidates);
 
-            bool tooCloseToPlayer = false;
-            bool withinRangeOfAnyPlayer = false;
+            int candidateCount = candidates.Count();
+            if (candidateCount == 0) continue;
 
-            foreach (vector playerPos : playerPositions)
+            // Walk the ring from a random offset so repeated ticks don't favour one road
+            int offset = SCR_TrafficRandom.RandomInt(0, candidateCount);
+            for (int c = 0; c < candidateCount; c++)
             {
-                float distToPlayer = vector.Distance(spawn, playerPos);
-                if (distToPlayer < m_fPlayerSafeRadius)
+                int pointId = candidates[(offset + c) % candidateCount];
+                if (m_RoadIndex.IsSpawnable(pointId) && IsValidSpawnPoint(m_RoadIndex.GetPosition(pointId)))
                 {
-                    tooCloseToPlayer = true;
+                    spawnPoint = pointId;
                     break;
                 }
-                if (!withinRangeOfAnyPlayer && distToPlayer < m_fDespawnDistance)
-                    withinRangeOfAnyPlayer = true;
             }
+        }
 
-            if (tooCloseToPlayer || !withinRangeOfAnyPlayer)
-                continue;
+        if (spawnPoint == -1) return false;
 
-            bool tooCloseToVehicle = false;
-            foreach (Vehicle existingVeh : m_aActiveVehicles)
-            {
-                if (!existingVeh) continue;
-                if (vector.Distance(spawn, existingVeh.GetOrigin()) < MIN_VEHICLE_SPACING)
-                {
-                    tooCloseToVehicle = true;
-                    break;
-                }
-            }
+        spawn = m_RoadIndex.GetPosition(spawnPoint);
 
-            if (tooCloseToVehicle)
-                continue;
+        // Destination comes from the spawn's own road component, so it is reachable by construction
+        int destPoint = m_RoadIndex.PickDestination(spawnPoint, MIN_DESTINATION_DISTANCE, MAX_DESTINATION_ATTEMPTS);
+        if (destPoint == -1) return false;
+
+        dest = m_RoadIndex.GetPosition(destPoint);
+        outHeading = m_RoadIndex.GetDirection(spawnPoint);
+        if (vector.Dot(outHeading, dest - spawn) < 0)
+            outHeading = outHeading * -1;
 
-            vector dPos = GetRandomMapPos();
-            if (vector.Distance(spawn, dPos) < 2000) continue;
+        return true;
+    }
 
-            vector validDestPos;
-            float searchRadius = 500.0;
+    // Materialises a virtual token that has entered the ring around a player in m_aSpawnOrder. The
+    // token is consumed; the car keeps its road position, direction of travel and destination.
+    protected bool FindVirtualSpawn(out vector spawn, out vector dest, out vector outHeading)
+    {
+        array<int> tokenIds = {};
 
-            if (roadMgr.GetReachableWaypointInRoad(spawn, dPos, searchRadius, validDestPos))
+        foreach (int player : m_aSpawnOrder)
+        {
+            tokenIds.Clear();
+            m_VirtualLayer.QueryRing(m_PlayerSnapshot.GetPosition(player), m_fPlayerSafeRadius, m_fDespawnDistance, tokenIds);
+
+            foreach (int tokenId : tokenIds)
             {
-                dest = validDestPos;
+                SCR_TrafficToken token = m_VirtualLayer.GetToken(tokenId);
+                vector pos = m_RoadIndex.GetPosition(token.m_iPoint);
+                if (!IsValidSpawnPoint(pos))
+                    continue;
+
+                spawn = pos;
+                dest = m_RoadIndex.GetPosition(token.m_iDestPoint);
+
+                // Road direction is stored for increasing point order; flip it for tokens driving the other way
+                outHeading = m_RoadIndex.GetDirection(token.m_iPoint) * token.m_iStep;
+
+                m_VirtualLayer.RemoveToken(tokenId);
                 return true;
             }
-
-            Print(string.Format("[TRAFFIC] Road at %1 is not reachable from %2 (Water or Gap). Retrying...", dPos, spawn), LogLevel.DEBUG);
         }
+
         return false;
     }
 
-    protected BaseRoad GetNearestRoad(vector center, float radius)
+    // A candidate must stay outside every player's safe radius and keep spacing to other traffic
+    protected bool IsValidSpawnPoint(vector pos)
     {
-        SCR_AIWorld aiWorld = SCR_AIWorld.Cast(GetGame().GetAIWorld());
-        if (!aiWorld) return null;
+        if (m_PlayerSnapshot.IsAnyPlayerWithin(pos, m_fPlayerSafeRadius))
+            return false;
 
-        RoadNetworkManager roadMgr = aiWorld.GetRoadNetworkManager();
-        if (!roadMgr) return null;
+        if (IsAnyVehicleNear(pos, MIN_VEHICLE_SPACING))
+            return false;
 
-        array<BaseRoad> roads = {};
-        roadMgr.GetRoadsInAABB(center - Vector(radius, radius, radius), center + Vector(radius, radius, radius), roads);
+        if (m_SpawnPipeline.IsJobNear(pos, MIN_VEHICLE_SPACING))
+            return false;
 
-        if (roads.Count() == 0) return null;
-        return roads.GetRandomElement();
+        return true;
     }
 
-    protected bool MoveDriverInVehicle(Vehicle vehicle, IEntity driver)
+    // Civilian threat nearby: drivers around it need full AI to react, whatever their distance band.
+    // Incidents are re-delivered while the fight goes on, which keeps the pins fresh.
+    protected void OnCivilianIncident(SCR_TrafficIncident incident)
     {
-        BaseCompartmentManagerComponent compMgr = BaseCompartmentManagerComponent.Cast(vehicle.FindComponent(BaseCompartmentManagerComponent));
-        CompartmentAccessComponent access = CompartmentAccessComponent.Cast(driver.FindComponent(CompartmentAccessComponent));
-        if (!compMgr || !access) return false;
+        if (incident.m_eState == ETrafficIncidentState.CLOSED)
+            return;
 
-        array<BaseCompartmentSlot> compartments = {};
-        compMgr.GetCompartments(compartments);
+        // Merged events lie anywhere within the incident radius of its position
+        float radius = THREAT_LOD_BUMP_RADIUS + SCR_TrafficEvents.CivilianEvents.GetIncidentRadius();
 
-        foreach (BaseCompartmentSlot slot : compartments)
-        {
-            if (slot.GetType() == ECompartmentType.PILOT)
-                return access.GetInVehicle(vehicle, slot, true, -1, ECloseDoorAfterActions.INVALID, false);
-        }
-        return false;
-    }
+        array<SCR_TrafficUnit> nearby = {};
+        GetUnitsNear(incident.m_vPosition, radius, nearby);
+        m_DriverLOD.Pin(nearby);
 
-    protected void OnDriverPanic(IEntity owner)
-    {
-        Print("[TRAFFIC EVENT] PANIC! Driver reacting.", LogLevel.WARNING);
-        SCR_TrafficEvents.OnCivilianEvent.Invoke(owner.GetOrigin(), "gunfight");
+        PropagatePanic(incident);
     }
 
-    protected void CleanupVehicle(Vehicle veh)
+    // Every car near the incident reacts in one pass, whether or not its own driver has noticed the
+    // threat yet. Drivers already panicking are skipped, so repeated deliveries only reach newcomers.
+    protected void PropagatePanic(SCR_TrafficIncident incident)
     {
-        if (!veh) return;
+        if (m_fPanicRadius <= 0 || incident.m_fSeverity < PANIC_MIN_SEVERITY)
+            return;
 
-        m_mVehicleDestinations.Remove(veh);
-        m_mLastLOSCheck.Remove(veh);
+        // Measured from the first event like the LOD pin: merged events lie anywhere within the
+        // incident radius of it, and each of them must still reach cars m_fPanicRadius around it
+        float radius = m_fPanicRadius + SCR_TrafficEvents.CivilianEvents.GetIncidentRadius();
 
-        SCR_TrafficEvents.OnTrafficVehicleDespawned.Invoke(veh);
+        array<SCR_TrafficUnit> nearby = {};
+        GetUnitsNear(incident.m_vPosition, radius, nearby);
 
-        string vehDesc = string.Format("%1", veh);
-        SCR_EntityHelper.DeleteEntityAndChildren(veh);
-        Print(string.Format("[TRAFFIC] Cleaned up vehicle %1", vehDesc), LogLevel.DEBUG);
-    }
+        int reacted = 0;
+        foreach (SCR_TrafficUnit unit : nearby)
+        {
+            if (reacted >= MAX_PANIC_REACTIONS)
+                break;
 
-    protected vector GetRandomMapPos()
-    {
-        vector mapMin, mapMax;
-        GetGame().GetWorldEntity().GetWorldBounds(mapMin, mapMax);
-        return Vector(Math.RandomFloat(mapMin[0], mapMax[0]), 0, Math.RandomFloat(mapMin[2], mapMax[2]));
-    }
+            if (!unit.m_Observer || !unit.m_Observer.React(m_ePanicReaction, incident.m_vPosition))
+                continue;
 
-    // ------------------------------------------------------------------------------------------------
-    // 5. Line of Sight Helpers
-    // ------------------------------------------------------------------------------------------------
+            reacted++;
+            OnUnitReacted(unit);
+        }
 
-    protected bool HasLineOfSight(vector from, vector to)
-    {
-        autoptr TraceParam trace = new TraceParam();
-        trace.Start = from;
-        trace.End = to;
-        trace.Flags = TraceFlags.WORLD | TraceFlags.ENTS;
-        trace.LayerMask = EPhysicsLayerPresets.Projectile;
+        if (reacted == 0)
+            return;
 
-        float hitDist = GetGame().GetWorld().TraceMove(trace, null);
-        return hitDist >= 1.0;
+        m_Stats.Count(ETrafficCounter.PANIC_REACTIONS, reacted);
+        if (SCR_TrafficLog.IsVerbose())
+            Print(string.Format("[TRAFFIC] %1 cars reacting to %2 incident at %3", reacted, typename.EnumToString(ETrafficCivilianEvent, incident.m_eType), incident.m_vPosition), LogLevel.NORMAL);
     }
 
-    protected bool IsVehicleVisibleToAnyPlayer(Vehicle veh)
+    // A fleeing car now heads for its escape point: progress and leg arrival are measured against
+    // that from here on instead of the abandoned destination
+    protected void OnUnitReacted(SCR_TrafficUnit unit)
     {
-        if (!veh) return false;
-
-        float currentTime = GetGame().GetWorld().GetWorldTime() / 1000.0;
+        vector escapePos;
+        if (!unit.m_Vehicle || !unit.m_Observer.GetEscapePosition(escapePos))
+            return;
 
-        if (m_mLastLOSCheck.Contains(veh))
-        {
-            float lastCheck = m_mLastLOSCheck[veh];
-            if (currentTime - lastCheck < LOS_CHECK_INTERVAL)
-                return true;
-        }
+        unit.m_vDestination = escapePos;
+        m_StuckMonitor.ResetReroutes(unit);
+        m_StuckMonitor.Track(unit, unit.m_Vehicle.GetOrigin());
+    }
 
-        m_mLastLOSCheck.Set(veh, currentTime);
+    // Parks the unit for reuse when the pool has room and it is intact, otherwise deletes it
+    protected void DespawnUnit(SCR_TrafficUnit unit, ETrafficDespawnReason reason)
+    {
+        UnindexUnit(unit);
+        m_Stats.Count(ETrafficCounter.DESPAWNED);
 
-        vector vehPos = veh.GetOrigin();
-        vehPos[1] = vehPos[1] + 2.0;
+        Vehicle veh = unit.m_Vehicle;
+        if (veh)
+            SCR_TrafficEvents.OnTrafficVehicleDespawned.Invoke(veh);
 
-        array<int> playerIds = {};
-        GetGame().GetPlayerManager().GetPlayers(playerIds);
+        // Only a car that drove out of range keeps driving virtually from its spot. Stuck and shed
+        // cars drop out of the population like wrecks; the virtual layer's top-up re-seeds it at
+        // a random road point instead of where the car would be materialised again at once.
+        if (veh && reason == ETrafficDespawnReason.OUT_OF_RANGE && unit.IsIntact())
+            m_VirtualLayer.AddTokenAt(veh.GetOrigin(), unit.m_vDestination);
 
-        foreach (int playerId : playerIds)
+        string vehDesc = string.Format("%1", veh);
+        if (m_VehiclePool.Park(unit, m_Relevance))
         {
-            IEntity player = GetGame().GetPlayerManager().GetPlayerControlledEntity(playerId);
-            if (!player) continue;
-
-            vector playerEyePos = player.GetOrigin();
-            playerEyePos[1] = playerEyePos[1] + TRAFFIC_VISIBILITY_CHECK_HEIGHT;
-
-            float dist = vector.Distance(vehPos, playerEyePos);
-            if (dist > m_fDespawnDistance) continue;
+            Print(string.Format("[TRAFFIC] Parked vehicle %1 in pool (%2/%3)", vehDesc, m_VehiclePool.GetCount(), m_VehiclePool.GetCapacity()), LogLevel.DEBUG);
+            return;
+        }
 
-            vector playerAngles = player.GetAngles();
-            vector playerDir = playerAngles.AnglesToVector();
-            vector toVehicle = vehPos - playerEyePos;
-            toVehicle.Normalize();
+        unit.Delete();
+        Print(string.Format("[TRAFFIC] Cleaned up vehicle %1", vehDesc), LogLevel.DEBUG);
+    }
 
-            float dotProduct = vector.Dot(playerDir, toVehicle);
-            if (dotProduct > 1.0) dotProduct = 1.0;
-            else if (dotProduct < -1.0) dotProduct = -1.0;
-            float viewAngle = Math.Acos(dotProduct) * Math.RAD2DEG;
+    protected void IndexUnit(SCR_TrafficUnit unit)
+    {
+        unit.m_iId = m_iNextUnitId;
+        m_iNextUnitId++;
 
-            if (viewAngle > 110) continue;
+        vector pos = unit.m_Vehicle.GetOrigin();
+        unit.m_iCellKey = m_UnitGrid.GetKey(pos);
+        m_UnitGrid.Insert(pos, unit.m_iId);
+        m_mUnitsById.Insert(unit.m_iId, unit);
+    }
 
-            if (HasLineOfSight(playerEyePos, vehPos))
-            {
-                Print(string.Format("[TRAFFIC DEBUG] Vehicle visible to player %1", playerId), LogLevel.DEBUG);
-                return true;
-            }
-        }
+    protected void UnindexUnit(SCR_TrafficUnit unit)
+    {
+        if (unit.m_iId == -1)
+            return;
 
-        return false;
+        m_UnitGrid.RemoveFromCell(unit.m_iCellKey, unit.m_iId);
+        m_mUnitsById.Remove(unit.m_iId);
+        unit.m_iId = -1;
     }
 }
 
 // ------------------------------------------------------------------------------------------------
-// Auto-Start Hook — owns the manager instance, no singleton needed
+// Auto-Start Hook — the game mode owns the single authoritative manager instance
 // ------------------------------------------------------------------------------------------------
-modded class SCR_PlayerController
+modded class SCR_BaseGameMode
 {
     protected ref SCR_AmbientTrafficManager m_TrafficManager;
 
-    override void OnControlledEntityChanged(IEntity from, IEntity to)
+    override void OnGameStart()
+    {
+        super.OnGameStart();
+
+        // One manager per session, only on authority (server or local play)
+        if (m_TrafficManager || (Replication.IsRunning() && !Replication.IsServer()))
+            return;
+
+        m_TrafficManager = new SCR_AmbientTrafficManager();
+        m_TrafficManager.Initialize();
+    }
+
+    override void OnGameEnd()
     {
-        super.OnControlledEntityChanged(from, to);
+        // Clients have no manager but may be polling for the stats overlay
+        SCR_PlayerController controller = SCR_PlayerController.Cast(GetGame().GetPlayerController());
+        if (controller)
+            controller.StopTrafficOverlay();
 
-        // Initialize once when first entity is controlled, only on authority (server or local play)
-        if (!m_TrafficManager && to && (Replication.IsServer() || !Replication.IsRunning()))
+        if (m_TrafficManager)
         {
-            m_TrafficManager = new SCR_AmbientTrafficManager();
-            GetGame().GetCallqueue().CallLater(m_TrafficManager.Initialize, 2000, false);
-            Print("[TRAFFIC] Traffic manager created, initializing in 2s...", LogLevel.NORMAL);
+            m_TrafficManager.Shutdown();
+            m_TrafficManager = null;
         }
+
+        SCR_CivilianObserverRegistry.Reset();
+
+        super.OnGameEnd();
+    }
+
+    SCR_AmbientTrafficManager GetTrafficManager()
+    {
+        return m_TrafficManager;
     }
 }
@@ -0,0 +1,309 @@
+enum ETrafficObserverTimer
+{
+    PANIC_RESET,
+    HANDBRAKE_RELEASE
+}
+
+// ------------------------------------------------------------------------------------------------
+// Server-side bookkeeping for every SCR_CivilianTrafficObserver. Civilians enrol on init; hooking
+// their threat systems is batched into one shared retry sweep (and done immediately when the
+// traffic spawn pipeline reports an agent as ready), and all panic / handbrake timers live in one
+// sorted list served by a single call-queue entry. Civilians with m_bObserveThreats unset, or
+// opted out at runtime via OptOut(), are never hooked.
+// ------------------------------------------------------------------------------------------------
+class SCR_CivilianObserverRegistry
+{
+    protected const int HOOK_SWEEP_INTERVAL_MS = 1000;
+    // Sweeps before a civilian whose AI agent never appears is given up on; a later readiness
+    // notification still hooks it
+    protected const int MAX_HOOK_ATTEMPTS = 20;
+
+    protected static ref SCR_CivilianObserverRegistry s_Instance;
+
+    protected bool m_bObservePlacedCivilians = true;
+
+    protected ref array<SCR_CivilianTrafficObserver> m_aActive = {};
+
+    // Active observers whose threat system is not hooked yet
+    protected ref array<SCR_CivilianTrafficObserver> m_aWaiting = {};
+    protected ref array<int> m_aWaitingAttempts = {};
+    protected bool m_bSweeping;
+    protected int m_iGivenUpTotal;
+
+    // Timer list, sorted by due time (world time, ms)
+    protected ref array<float> m_aTimerDue = {};
+    protected ref array<SCR_CivilianTrafficObserver> m_aTimerObservers = {};
+    protected ref array<ETrafficObserverTimer> m_aTimerKinds = {};
+    protected bool m_bTimerArmed;
+
+    // ------------------------------------------------------------------------------------------------
+    static SCR_CivilianObserverRegistry GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new SCR_CivilianObserverRegistry();
+
+        return s_Instance;
+    }
+
+    // The registry if one was created, without creating it (for teardown paths)
+    static SCR_CivilianObserverRegistry GetExisting()
+    {
+        return s_Instance;
+    }
+
+    void SCR_CivilianObserverRegistry()
+    {
+        SCR_MissionHeader header = SCR_MissionHeader.Cast(GetGame().GetMissionHeader());
+        if (header && header.m_TrafficEventSettings)
+            m_bObservePlacedCivilians = header.m_TrafficEventSettings.m_bObservePlacedCivilians;
+    }
+
+    // Drops every observer and timer, e.g. when the mission ends
+    static void Reset()
+    {
+        if (!s_Instance)
+            return;
+
+        s_Instance.StopCallbacks();
+        s_Instance = null;
+    }
+
+    // Stops and unhooks the character's observer; its traffic car keeps driving but won't react
+    static void OptOut(IEntity character)
+    {
+        SCR_CivilianTrafficObserver observer = FindObserver(character);
+        if (observer)
+            observer.SetObserved(false);
+    }
+
+    static void OptIn(IEntity character)
+    {
+        SCR_CivilianTrafficObserver observer = FindObserver(character);
+        if (observer)
+            observer.SetObserved(true);
+    }
+
+    int GetActiveCount()
+    {
+        return m_aActive.Count();
+    }
+
+    int GetWaitingCount()
+    {
+        return m_aWaiting.Count();
+    }
+
+    int GetTimerCount()
+    {
+        return m_aTimerDue.Count();
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Called from the observer's OnPostInit. Placed civilians are only activated when the mission
+    // observes them; traffic drivers are activated through NotifyAgentReady.
+    void Enrol(SCR_CivilianTrafficObserver observer)
+    {
+        if (!m_bObservePlacedCivilians || !observer.IsObserved())
+            return;
+
+        Activate(observer);
+    }
+
+    // Readiness event: the character's AI agent exists, so its threat system can be hooked now
+    void NotifyAgentReady(SCR_CivilianTrafficObserver observer)
+    {
+        if (!observer.IsObserved())
+            return;
+
+        Activate(observer);
+        if (!observer.TryHookThreatSystem())
+            return;
+
+        int index = m_aWaiting.Find(observer);
+        if (index != -1)
+            RemoveWaiting(index);
+    }
+
+    // Forgets the observer and cancels its timers
+    void Withdraw(SCR_CivilianTrafficObserver observer)
+    {
+        m_aActive.RemoveItem(observer);
+
+        int index = m_aWaiting.Find(observer);
+        if (index != -1)
+            RemoveWaiting(index);
+
+        for (int i = m_aTimerObservers.Count() - 1; i >= 0; i--)
+        {
+            if (m_aTimerObservers[i] == observer)
+                RemoveTimer(i);
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Calls observer.OnRegistryTimer(kind) after delayMs; an earlier timer of the same kind is replaced
+    void Schedule(SCR_CivilianTrafficObserver observer, ETrafficObserverTimer kind, int delayMs)
+    {
+        Cancel(observer, kind);
+
+        float due = GetGame().GetWorld().GetWorldTime() + delayMs;
+
+        // Binary search for the first timer due later than this one
+        int low = 0;
+        int high = m_aTimerDue.Count();
+        while (low < high)
+        {
+            int mid = (low + high) / 2;
+            if (m_aTimerDue[mid] <= due)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        m_aTimerDue.InsertAt(due, low);
+        m_aTimerObservers.InsertAt(observer, low);
+        m_aTimerKinds.InsertAt(kind, low);
+
+        if (low == 0)
+            ArmTimer();
+    }
+
+    void Cancel(SCR_CivilianTrafficObserver observer, ETrafficObserverTimer kind)
+    {
+        for (int i = m_aTimerObservers.Count() - 1; i >= 0; i--)
+        {
+            if (m_aTimerObservers[i] == observer && m_aTimerKinds[i] == kind)
+                RemoveTimer(i);
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected static SCR_CivilianTrafficObserver FindObserver(IEntity character)
+    {
+        if (!character)
+            return null;
+
+        return SCR_CivilianTrafficObserver.Cast(character.FindComponent(SCR_CivilianTrafficObserver));
+    }
+
+    protected void Activate(SCR_CivilianTrafficObserver observer)
+    {
+        if (m_aActive.Contains(observer))
+            return;
+
+        m_aActive.Insert(observer);
+        observer.HookDamage();
+
+        m_aWaiting.Insert(observer);
+        m_aWaitingAttempts.Insert(0);
+        if (!m_bSweeping)
+        {
+            m_bSweeping = true;
+            GetGame().GetCallqueue().CallLater(SweepWaiting, HOOK_SWEEP_INTERVAL_MS, true);
+        }
+    }
+
+    // One pass over every civilian still waiting for its AI agent
+    protected void SweepWaiting()
+    {
+        int givenUp = 0;
+        for (int i = m_aWaiting.Count() - 1; i >= 0; i--)
+        {
+            SCR_CivilianTrafficObserver observer = m_aWaiting[i];
+            if (!observer || observer.TryHookThreatSystem())
+            {
+                RemoveWaiting(i);
+                continue;
+            }
+
+            m_aWaitingAttempts[i] = m_aWaitingAttempts[i] + 1;
+            if (m_aWaitingAttempts[i] >= MAX_HOOK_ATTEMPTS)
+            {
+                RemoveWaiting(i);
+                givenUp++;
+            }
+        }
+
+        if (givenUp > 0)
+        {
+            m_iGivenUpTotal += givenUp;
+            if (SCR_TrafficLog.IsVerbose())
+                Print(string.Format("[TRAFFIC DEBUG] Gave up hooking %1 civilians without an AI agent (%2 total)", givenUp, m_iGivenUpTotal), LogLevel.NORMAL);
+        }
+
+        if (m_aWaiting.IsEmpty())
+        {
+            GetGame().GetCallqueue().Remove(SweepWaiting);
+            m_bSweeping = false;
+        }
+    }
+
+    protected void RemoveWaiting(int index)
+    {
+        m_aWaiting.Remove(index);
+        m_aWaitingAttempts.Remove(index);
+    }
+
+    // Fires every due timer, then re-arms for the next one
+    protected void ProcessTimers()
+    {
+        m_bTimerArmed = false;
+        float now = GetGame().GetWorld().GetWorldTime();
+
+        while (!m_aTimerDue.IsEmpty() && m_aTimerDue[0] <= now)
+        {
+            SCR_CivilianTrafficObserver observer = m_aTimerObservers[0];
+            ETrafficObserverTimer kind = m_aTimerKinds[0];
+            RemoveTimer(0);
+
+            if (observer)
+                observer.OnRegistryTimer(kind);
+        }
+
+        ArmTimer();
+    }
+
+    // Points the single call-queue entry at the earliest timer
+    protected void ArmTimer()
+    {
+        ScriptCallQueue queue = GetGame().GetCallqueue();
+        if (m_bTimerArmed)
+        {
+            queue.Remove(ProcessTimers);
+            m_bTimerArmed = false;
+        }
+
+        if (m_aTimerDue.IsEmpty())
+            return;
+
+        int delay = Math.Max(0, m_aTimerDue[0] - GetGame().GetWorld().GetWorldTime());
+        queue.CallLater(ProcessTimers, delay);
+        m_bTimerArmed = true;
+    }
+
+    protected void RemoveTimer(int index)
+    {
+        m_aTimerDue.RemoveOrdered(index);
+        m_aTimerObservers.RemoveOrdered(index);
+        m_aTimerKinds.RemoveOrdered(index);
+    }
+
+    protected void StopCallbacks()
+    {
+        ScriptCallQueue queue = GetGame().GetCallqueue();
+        if (queue)
+        {
+            queue.Remove(SweepWaiting);
+            queue.Remove(ProcessTimers);
+        }
+
+        m_bSweeping = false;
+        m_bTimerArmed = false;
+        m_aActive.Clear();
+        m_aWaiting.Clear();
+        m_aWaitingAttempts.Clear();
+        m_aTimerDue.Clear();
+        m_aTimerObservers.Clear();
+        m_aTimerKinds.Clear();
+    }
+}
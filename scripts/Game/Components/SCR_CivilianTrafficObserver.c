@@ -1,49 +1,140 @@
+// What a driver does when a civilian incident reaches it
+enum ETrafficPanicReaction
+{
+	FLEE,	// drive away from the threat
+	STOP	// clear the route and stay put until the panic wears off
+}
+
 [ComponentEditorProps(category: "Traffic System")]
 class SCR_CivilianTrafficObserverClass : ScriptComponentClass {}
 
 class SCR_CivilianTrafficObserver : ScriptComponent
 {
+	// Severity attached to the events this component raises
+	static const float SEVERITY_ALERTED = 0.25;
+	static const float SEVERITY_VIGILANT = 0.5;
+	static const float SEVERITY_PANIC = 0.75;
+	static const float SEVERITY_KILLED = 1.0;
+
+	protected static const int PANIC_DURATION_MS = 60000;
+	protected static const float FLEE_DISTANCE = 500.0;
+
+	[Attribute("1", desc: "React to threats and report civilian events. Untick on placed characters the mission drives itself.")]
+	protected bool m_bObserveThreats;
+
 	protected bool m_bPanicked = false;
 	protected bool m_bKilled = false;
 	protected SCR_CharacterDamageManagerComponent m_pDamageManager;
 	protected SCR_AIThreatSystem m_ThreatSystem;
+	protected CarControllerComponent m_HandbrakeController;
+	// Spawned by SpawnEscapeWaypoint when no traffic pool is running; the only waypoint we delete
+	protected AIWaypoint m_EscapeWaypoint;
+	// Where the current flee order leads; valid while m_bFleeing
+	protected vector m_vEscapePosition;
+	protected bool m_bFleeing;
 
 	//------------------------------------------------------------------------------------------------
+	// Hooks and timers are owned by SCR_CivilianObserverRegistry; nothing is scheduled per character
 	override void OnPostInit(IEntity owner)
 	{
-	    if (!Replication.IsServer()) return;
-	
-	    // Damage manager is usually internal to the prefab and safe to hook immediately
-	    m_pDamageManager = SCR_CharacterDamageManagerComponent.Cast(owner.FindComponent(SCR_CharacterDamageManagerComponent));
-	    if (m_pDamageManager)
-	        m_pDamageManager.GetOnDamageStateChanged().Insert(OnDamageStateChanged);
-	
-	    // Delay the threat system hook by a few frames to let the AI "Brain" connect to the "Body"
-	    GetGame().GetCallqueue().CallLater(TryHookThreatSystem, 1000, false, owner);
+		if (!Replication.IsServer()) return;
+
+		SCR_CivilianObserverRegistry.GetInstance().Enrol(this);
 	}
-	
-	// Separate the logic so we can call it after a delay
-	protected void TryHookThreatSystem(IEntity owner)
+
+	// Called by the traffic spawn pipeline as soon as the driver's agent exists
+	void OnAgentReady()
 	{
-	    SCR_AICombatComponent combatComp = SCR_AICombatComponent.Cast(owner.FindComponent(SCR_AICombatComponent));
-	    if (!combatComp) return;
-	
-	    SCR_ChimeraAIAgent agent = combatComp.GetAiAgent();
-	    if (!agent)
-	    {
-	        // If it's still null, try one more time in 2 seconds
-	        Print("[TRAFFIC DEBUG] AI Agent not found yet, retrying...", LogLevel.WARNING);
-	        GetGame().GetCallqueue().CallLater(TryHookThreatSystem, 2000, false, owner);
-	        return;
-	    }
-	
-	    SCR_AIUtilityComponent utility = SCR_AIUtilityComponent.Cast(agent.FindComponent(SCR_AIUtilityComponent));
-	    if (utility && utility.m_ThreatSystem)
-	    {
-	        m_ThreatSystem = utility.m_ThreatSystem;
-	        m_ThreatSystem.GetOnThreatStateChanged().Insert(OnThreatStateChanged);
-	        Print("[TRAFFIC DEBUG] Threat System Hooked Successfully!", LogLevel.NORMAL);
-	    }
+		SCR_CivilianObserverRegistry.GetInstance().NotifyAgentReady(this);
+	}
+
+	bool IsObserved()
+	{
+		return m_bObserveThreats;
+	}
+
+	// From React() until the PANIC_RESET timer fires; the traffic manager leaves the car alone meanwhile
+	bool IsPanicked()
+	{
+		return m_bPanicked;
+	}
+
+	// The flee target while the driver is fleeing; false when it stopped instead or calmed down
+	bool GetEscapePosition(out vector pos)
+	{
+		if (!m_bPanicked || !m_bFleeing) return false;
+
+		pos = m_vEscapePosition;
+		return true;
+	}
+
+	// Runtime opt-out / opt-in, see SCR_CivilianObserverRegistry.OptOut
+	void SetObserved(bool observed)
+	{
+		if (observed == m_bObserveThreats) return;
+
+		m_bObserveThreats = observed;
+		if (observed)
+		{
+			SCR_CivilianObserverRegistry.GetInstance().NotifyAgentReady(this);
+			return;
+		}
+
+		Unhook();
+		SCR_CivilianObserverRegistry.GetInstance().Withdraw(this);
+	}
+
+	// The damage manager is internal to the prefab and can be hooked as soon as the registry activates us
+	void HookDamage()
+	{
+		if (m_pDamageManager) return;
+
+		m_pDamageManager = SCR_CharacterDamageManagerComponent.Cast(GetOwner().FindComponent(SCR_CharacterDamageManagerComponent));
+		if (m_pDamageManager)
+			m_pDamageManager.GetOnDamageStateChanged().Insert(OnDamageStateChanged);
+	}
+
+	// True once the threat system is hooked; false while the AI agent does not exist yet
+	bool TryHookThreatSystem()
+	{
+		if (m_ThreatSystem) return true;
+
+		SCR_AICombatComponent combatComp = SCR_AICombatComponent.Cast(GetOwner().FindComponent(SCR_AICombatComponent));
+		if (!combatComp) return false;
+
+		SCR_ChimeraAIAgent agent = combatComp.GetAiAgent();
+		if (!agent) return false;
+
+		SCR_AIUtilityComponent utility = SCR_AIUtilityComponent.Cast(agent.FindComponent(SCR_AIUtilityComponent));
+		if (!utility || !utility.m_ThreatSystem) return false;
+
+		m_ThreatSystem = utility.m_ThreatSystem;
+		m_ThreatSystem.GetOnThreatStateChanged().Insert(OnThreatStateChanged);
+		if (SCR_TrafficLog.IsVerbose())
+			Print("[TRAFFIC DEBUG] Threat System Hooked Successfully!", LogLevel.NORMAL);
+
+		return true;
+	}
+
+	protected void Unhook()
+	{
+		if (m_pDamageManager)
+			m_pDamageManager.GetOnDamageStateChanged().Remove(OnDamageStateChanged);
+
+		if (m_ThreatSystem)
+			m_ThreatSystem.GetOnThreatStateChanged().Remove(OnThreatStateChanged);
+
+		m_pDamageManager = null;
+		m_ThreatSystem = null;
+	}
+
+	// Dispatched by the registry's timer list
+	void OnRegistryTimer(ETrafficObserverTimer timer)
+	{
+		if (timer == ETrafficObserverTimer.PANIC_RESET)
+			m_bPanicked = false;
+		else if (timer == ETrafficObserverTimer.HANDBRAKE_RELEASE)
+			ReleaseHandbrake();
 	}
 
 	//------------------------------------------------------------------------------------------------
@@ -58,29 +149,49 @@ class SCR_CivilianTrafficObserver : ScriptComponent
 		if (newState == EAIThreatState.ALERTED && 
 		prevState != EAIThreatState.THREATENED && 
 		prevState != EAIThreatState.VIGILANT) {
-			SCR_TrafficEvents.OnCivilianEvent.Invoke(owner.GetOrigin(), "gunfight");
-			Print(string.Format("[TRAFFIC DEBUG] Gunfight Event Fired. State: %1", typename.EnumToString(EAIThreatState, newState)), LogLevel.NORMAL);
+			SCR_TrafficEvents.CivilianEvents.Raise(ETrafficCivilianEvent.GUNFIGHT, owner, SEVERITY_ALERTED);
+			if (SCR_TrafficLog.IsVerbose())
+				Print(string.Format("[TRAFFIC DEBUG] Gunfight Event Fired. State: %1", typename.EnumToString(EAIThreatState, newState)), LogLevel.NORMAL);
 		}
 		if (newState == EAIThreatState.VIGILANT && 
 		prevState != EAIThreatState.THREATENED) {
-			SCR_TrafficEvents.OnCivilianEvent.Invoke(owner.GetOrigin(), "gunfight");
-			Print(string.Format("[TRAFFIC DEBUG] Gunfight Event Fired. State: %1", typename.EnumToString(EAIThreatState, newState)), LogLevel.NORMAL);
+			SCR_TrafficEvents.CivilianEvents.Raise(ETrafficCivilianEvent.GUNFIGHT, owner, SEVERITY_VIGILANT);
+			if (SCR_TrafficLog.IsVerbose())
+				Print(string.Format("[TRAFFIC DEBUG] Gunfight Event Fired. State: %1", typename.EnumToString(EAIThreatState, newState)), LogLevel.NORMAL);
 		}
 		if (newState == EAIThreatState.THREATENED)
 		{
-			m_bPanicked = true;
+			// The incident usually makes every car around, this one included, react in one pass
+			SCR_TrafficEvents.CivilianEvents.Raise(ETrafficCivilianEvent.PANIC, owner, SEVERITY_PANIC);
 			
-			SCR_TrafficEvents.OnCivilianEvent.Invoke(owner.GetOrigin(), "gunfight");
+			if (SCR_TrafficLog.IsVerbose())
+				Print(string.Format("[TRAFFIC DEBUG] Panic Event Fired. State: %1", typename.EnumToString(EAIThreatState, newState)), LogLevel.NORMAL);
 			
-			Print(string.Format("[TRAFFIC DEBUG] Panic Event Fired. State: %1", typename.EnumToString(EAIThreatState, newState)), LogLevel.NORMAL);
-			
-			StartFleeing(owner);
-			
-			// Reset panic state after 60 seconds
-			GetGame().GetCallqueue().CallLater(ResetPanic, 60000);
+			// Not reached by it (traffic not running, or merged into an incident without a new delivery):
+			// react like the cars around it would; the threat is somewhere ahead, so a flee turns around
+			React(SCR_AmbientTrafficManager.GetPanicReaction(), owner.GetOrigin() + owner.GetWorldTransformAxis(2));
 		}
 	}
 
+	//------------------------------------------------------------------------------------------------
+	// Puts the driver into panic for a while. False if it is already panicking, dead or opted out.
+	bool React(ETrafficPanicReaction reaction, vector threatPos)
+	{
+		if (m_bPanicked || m_bKilled || !m_bObserveThreats) return false;
+
+		m_bPanicked = true;
+		m_bFleeing = false;
+		SCR_CivilianObserverRegistry.GetInstance().Schedule(this, ETrafficObserverTimer.PANIC_RESET, PANIC_DURATION_MS);
+
+		IEntity owner = GetOwner();
+		if (reaction == ETrafficPanicReaction.STOP)
+			StopVehicle(owner);
+		else
+			StartFleeing(owner, threatPos);
+
+		return true;
+	}
+
 	//------------------------------------------------------------------------------------------------
 	void OnDamageStateChanged()
 	{
@@ -89,71 +200,141 @@ class SCR_CivilianTrafficObserver : ScriptComponent
 		if (m_pDamageManager.GetState() == EDamageState.DESTROYED)
 		{
 			m_bKilled = true;
-			SCR_TrafficEvents.OnCivilianEvent.Invoke(GetOwner().GetOrigin(), "killed");
-			Print("[TRAFFIC DEBUG] Death Event Fired", LogLevel.NORMAL);
+			SCR_TrafficEvents.CivilianEvents.Raise(ETrafficCivilianEvent.KILLED, GetOwner(), SEVERITY_KILLED);
+			if (SCR_TrafficLog.IsVerbose())
+				Print("[TRAFFIC DEBUG] Death Event Fired", LogLevel.NORMAL);
 		}
 	}
 
 	//------------------------------------------------------------------------------------------------
-	protected void StartFleeing(IEntity owner)
+	protected void StartFleeing(IEntity owner, vector threatPos)
 	{
-		AIControlComponent aiControl = AIControlComponent.Cast(owner.FindComponent(AIControlComponent));
-		if (!aiControl) return;
+		SCR_AIGroup group = GetGroup(owner);
+		if (!group) return;
 
-		AIAgent agent = aiControl.GetControlAIAgent();
-		if (!agent) return;
+		// Escape point on the road network, away from the threat
+		vector fleePos;
+		SCR_TrafficFleeRouter router = SCR_AmbientTrafficManager.GetFleeRouter();
+		if (!router || !router.FindEscapePosition(owner.GetOrigin(), threatPos, fleePos))
+			fleePos = GetStraightEscapePosition(owner, threatPos);
 
-		SCR_AIGroup group = SCR_AIGroup.Cast(agent.GetParentGroup());
-		if (!group) return;
+		// Traffic waypoints go back to the pool; a placed civilian's own waypoints are only detached
+		SCR_AIWaypoint escapeWp;
+		SCR_TrafficWaypointPool pool = SCR_AmbientTrafficManager.GetWaypointPool();
+		if (pool)
+		{
+			pool.ClearGroup(group);
+			escapeWp = SCR_AIWaypoint.Cast(pool.Assign(group, fleePos, 20.0));
+		}
+		else
+		{
+			escapeWp = SpawnEscapeWaypoint(group, fleePos);
+		}
+		
+		if (!escapeWp) return;
 
-		// Clear old waypoints
-		array<AIWaypoint> waypoints = {};
-		group.GetWaypoints(waypoints);
-		foreach (AIWaypoint wp : waypoints)
-			group.RemoveWaypoint(wp);
+		escapeWp.SetCompletionType(EAIWaypointCompletionType.Any);
+		m_vEscapePosition = fleePos;
+		m_bFleeing = true;
+	}
+
+	// Without a road index (traffic not running, or off-road): straight away from the threat, or
+	// straight back when the threat is right on top of us
+	protected vector GetStraightEscapePosition(IEntity owner, vector threatPos)
+	{
+		vector away = owner.GetOrigin() - threatPos;
+		away[1] = 0;
+		if (away.LengthSq() < 1)
+			away = owner.GetWorldTransformAxis(2) * -1;
 
-		// Calculate escape point: 500m behind current heading
-		vector fleePos = owner.GetOrigin() - (owner.GetWorldTransformAxis(2) * 500);
+		return owner.GetOrigin() + away.Normalized() * FLEE_DISTANCE;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Drops the route and holds the car on the handbrake until the panic wears off; the traffic
+	// manager chains no leg while IsPanicked() and gives it a new one on the first tick after
+	protected void StopVehicle(IEntity owner)
+	{
+		SCR_AIGroup group = GetGroup(owner);
+		if (group)
+		{
+			SCR_TrafficWaypointPool pool = SCR_AmbientTrafficManager.GetWaypointPool();
+			if (pool)
+				pool.ClearGroup(group);
+			else
+				ClearWaypoints(group);
+		}
+
+		Vehicle vehicle = GetVehicle(owner);
+		if (!vehicle) return;
+
+		m_HandbrakeController = CarControllerComponent.Cast(vehicle.FindComponent(CarControllerComponent));
+		if (!m_HandbrakeController) return;
+
+		m_HandbrakeController.SetPersistentHandBrake(true);
+		SCR_CivilianObserverRegistry.GetInstance().Schedule(this, ETrafficObserverTimer.HANDBRAKE_RELEASE, PANIC_DURATION_MS);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	// Fallback when the traffic manager is not running (e.g. a civilian placed by hand)
+	protected SCR_AIWaypoint SpawnEscapeWaypoint(SCR_AIGroup group, vector fleePos)
+	{
+		ClearWaypoints(group);
 
-		// Create and Configure Waypoint
 		ResourceName wpPrefab = "{750A8D1695BD6998}Prefabs/AI/Waypoints/AIWaypoint_Move.et";
 		EntitySpawnParams params = new EntitySpawnParams();
 		params.Transform[3] = fleePos;
 
-		IEntity wpEnt = GetGame().SpawnEntityPrefab(Resource.Load(wpPrefab), GetGame().GetWorld(), params);
-		SCR_AIWaypoint escapeWp = SCR_AIWaypoint.Cast(wpEnt);
-		
+		SCR_AIWaypoint escapeWp = SCR_AIWaypoint.Cast(GetGame().SpawnEntityPrefab(SCR_AmbientTrafficManager.LoadPrefab(wpPrefab), GetGame().GetWorld(), params));
 		if (escapeWp)
 		{
 			escapeWp.SetCompletionRadius(20.0);
-			escapeWp.SetCompletionType(EAIWaypointCompletionType.Any);
 			group.AddWaypoint(escapeWp);
-			
-			Vehicle vehicle = GetVehicle(owner);
-			if (vehicle)
-			{
-				CarControllerComponent carController = CarControllerComponent.Cast(vehicle.FindComponent(CarControllerComponent));
-				if (carController)
-				{
-					carController.SetPersistentHandBrake(true);
-					GetGame().GetCallqueue().CallLater(ReleaseHandbrake, 2000, false, carController);
-				}
-			}
+			m_EscapeWaypoint = escapeWp;
 		}
+
+		return escapeWp;
 	}
-	
+
 	//------------------------------------------------------------------------------------------------
-	protected void ReleaseHandbrake(CarControllerComponent carController)
+	protected void ReleaseHandbrake()
 	{
-		if (carController)
+		if (m_HandbrakeController)
 		{
-			carController.SetPersistentHandBrake(false);
-			Print("[TRAFFIC DEBUG] Handbrake RELEASED - Flooring it", LogLevel.NORMAL);
+			m_HandbrakeController.SetPersistentHandBrake(false);
+			m_HandbrakeController = null;
+			if (SCR_TrafficLog.IsVerbose())
+				Print("[TRAFFIC DEBUG] Handbrake RELEASED - Flooring it", LogLevel.NORMAL);
 		}
 	}
 
-	protected void ResetPanic() { m_bPanicked = false; }
-	
+	// Detaches every waypoint from the group; only our own escape waypoint is deleted, the rest
+	// belong to whoever placed the civilian
+	protected void ClearWaypoints(SCR_AIGroup group)
+	{
+		array<AIWaypoint> waypoints = {};
+		group.GetWaypoints(waypoints);
+		foreach (AIWaypoint wp : waypoints)
+			group.RemoveWaypoint(wp);
+
+		if (m_EscapeWaypoint)
+		{
+			SCR_EntityHelper.DeleteEntityAndChildren(m_EscapeWaypoint);
+			m_EscapeWaypoint = null;
+		}
+	}
+
+	protected SCR_AIGroup GetGroup(IEntity owner)
+	{
+		AIControlComponent aiControl = AIControlComponent.Cast(owner.FindComponent(AIControlComponent));
+		if (!aiControl) return null;
+
+		AIAgent agent = aiControl.GetControlAIAgent();
+		if (!agent) return null;
+
+		return SCR_AIGroup.Cast(agent.GetParentGroup());
+	}
+
 	protected Vehicle GetVehicle(IEntity owner)
 	{
 		SCR_CompartmentAccessComponent compartmentAccess = SCR_CompartmentAccessComponent.Cast(owner.FindComponent(SCR_CompartmentAccessComponent));
@@ -169,10 +350,10 @@ class SCR_CivilianTrafficObserver : ScriptComponent
 	override void OnDelete(IEntity owner)
 	{
 		// Critical: Clean up listeners to prevent Null Pointer crashes
-		if (m_pDamageManager)
-			m_pDamageManager.GetOnDamageStateChanged().Remove(OnDamageStateChanged);
-			
-		if (m_ThreatSystem)
-			m_ThreatSystem.GetOnThreatStateChanged().Remove(OnThreatStateChanged);
+		Unhook();
+
+		SCR_CivilianObserverRegistry registry = SCR_CivilianObserverRegistry.GetExisting();
+		if (registry)
+			registry.Withdraw(this);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,280 @@
+// ------------------------------------------------------------------------------------------------
+// Repeatable soak test for the traffic system. Real players are replaced by synthetic observers
+// that drive the road network from seeded start points, the traffic RNG is seeded, and the
+// manager is run for a fixed time at each configured vehicle cap. Each stage records per-tick
+// loop time, spawn pipeline time and server frame time, plus spawn success, traces and entity
+// churn; the results go to a JSON file in the profile directory. Needs no player, so it runs on
+// a headless dedicated server. AI driving and physics are not seeded, so compare percentiles
+// between builds rather than expecting identical runs.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficBenchmark
+{
+    protected const string RESULTS_DIRECTORY = "$profile:GRAD_Traffic";
+
+    protected SCR_AmbientTrafficManager m_Manager;
+    protected ref SCR_TrafficVirtualLayer m_Observers;
+
+    protected int m_iSeed;
+    protected int m_iObserverCount;
+    protected int m_iWarmupTicks;
+    protected int m_iMeasureTicks;
+    protected bool m_bQuitWhenDone;
+    protected ref array<int> m_aCaps = {};
+
+    protected int m_iStage = -1;
+    protected int m_iStageTick;
+    protected bool m_bFinished;
+
+    // Samples of the running stage's measurement window
+    protected ref array<float> m_aLoopMs = {};
+    protected ref array<float> m_aPipelineMs = {};
+    protected ref array<float> m_aFrameMs = {};
+    protected ref array<int> m_aCounterStart = {};
+    protected int m_iLastPipelineTotal;
+    protected int m_iActiveSum;
+
+    protected ref array<string> m_aStageResults = {};
+    protected ref array<vector> m_aPoseBuffer = {};
+    protected ref array<vector> m_aDirectionBuffer = {};
+
+    // ------------------------------------------------------------------------------------------------
+    void SCR_TrafficBenchmark(SCR_AmbientTrafficManager manager, SCR_TrafficRoadIndex roadIndex, GRAD_TRAFFIC_TrafficBenchmarkSettings settings)
+    {
+        m_Manager = manager;
+        m_iSeed = settings.m_iSeed;
+        m_iObserverCount = Math.Max(1, settings.m_iSyntheticObservers);
+        m_iWarmupTicks = Math.Max(0, settings.m_iWarmupSeconds);
+        m_iMeasureTicks = Math.Max(1, settings.m_iStageSeconds);
+        m_bQuitWhenDone = settings.m_bQuitWhenDone;
+        ParseCaps(settings.m_sVehicleCaps);
+
+        m_Observers = new SCR_TrafficVirtualLayer(roadIndex);
+        m_Observers.SetSpeed(settings.m_fObserverSpeed);
+        m_Observers.SetTargetPopulation(m_iObserverCount);
+    }
+
+    // Seeds the RNG, places observers and sets the first cap. False if there is nothing to run.
+    bool Start()
+    {
+        if (m_aCaps.IsEmpty())
+        {
+            Print("[TRAFFIC BENCHMARK] No vehicle caps configured, benchmark not started.", LogLevel.WARNING);
+            return false;
+        }
+
+        SCR_TrafficRandom.Seed(m_iSeed);
+        m_Observers.Populate();
+        if (m_Observers.GetTokenCount() == 0)
+        {
+            Print("[TRAFFIC BENCHMARK] Could not place synthetic observers on the road index.", LogLevel.WARNING);
+            return false;
+        }
+
+        Print(string.Format("[TRAFFIC BENCHMARK] Started: seed %1, %2 observers, %3 stages of %4 + %5 s",
+            m_iSeed, m_Observers.GetTokenCount(), m_aCaps.Count(), m_iWarmupTicks, m_iMeasureTicks), LogLevel.NORMAL);
+
+        NextStage();
+        return true;
+    }
+
+    bool IsFinished()
+    {
+        return m_bFinished;
+    }
+
+    // Replaces the player capture at the top of the traffic tick
+    void CaptureObservers(SCR_TrafficPlayerSnapshot snapshot, float dt)
+    {
+        m_Observers.Update(dt, 0);
+
+        m_aPoseBuffer.Clear();
+        m_aDirectionBuffer.Clear();
+        m_Observers.GetTokenPoses(m_aPoseBuffer, m_aDirectionBuffer);
+
+        snapshot.Clear();
+        foreach (int i, vector pos : m_aPoseBuffer)
+            snapshot.AddSyntheticObserver(-1 - i, pos, m_aDirectionBuffer[i]);
+    }
+
+    // Called at the end of every traffic tick
+    void OnTick()
+    {
+        if (m_bFinished)
+            return;
+
+        SCR_TrafficStats stats = m_Manager.GetStats();
+        m_iStageTick++;
+
+        if (m_iStageTick == m_iWarmupTicks)
+            BeginMeasurement(stats);
+
+        if (m_iStageTick > m_iWarmupTicks)
+        {
+            m_aLoopMs.Insert(stats.GetLastMs(ETrafficPhase.TICK));
+
+            // The pipeline runs every frame between ticks; take what it spent since the last one
+            int pipelineTotal = stats.GetTotalMs(ETrafficPhase.SPAWN_STAGES);
+            m_aPipelineMs.Insert(pipelineTotal - m_iLastPipelineTotal);
+            m_iLastPipelineTotal = pipelineTotal;
+
+            m_aFrameMs.Insert(GetGame().GetWorld().GetTimeSlice() * 1000.0);
+            m_iActiveSum += m_Manager.GetActiveCount();
+        }
+
+        if (m_iStageTick < m_iWarmupTicks + m_iMeasureTicks)
+            return;
+
+        FinishStage(stats);
+        NextStage();
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected void NextStage()
+    {
+        m_iStage++;
+        if (m_iStage >= m_aCaps.Count())
+        {
+            Finish();
+            return;
+        }
+
+        m_iStageTick = 0;
+        m_Manager.SetVehicleCap(m_aCaps[m_iStage]);
+        Print(string.Format("[TRAFFIC BENCHMARK] Stage %1/%2: cap %3", m_iStage + 1, m_aCaps.Count(), m_aCaps[m_iStage]), LogLevel.NORMAL);
+
+        // A stage without warm-up starts measuring right away
+        if (m_iWarmupTicks == 0)
+            BeginMeasurement(m_Manager.GetStats());
+    }
+
+    protected void BeginMeasurement(SCR_TrafficStats stats)
+    {
+        m_aLoopMs.Clear();
+        m_aPipelineMs.Clear();
+        m_aFrameMs.Clear();
+        m_iActiveSum = 0;
+        m_iLastPipelineTotal = stats.GetTotalMs(ETrafficPhase.SPAWN_STAGES);
+
+        m_aCounterStart.Clear();
+        for (int i = 0; i < SCR_TrafficStats.COUNTER_COUNT; i++)
+            m_aCounterStart.Insert(stats.GetTotal(i));
+    }
+
+    protected void FinishStage(SCR_TrafficStats stats)
+    {
+        int attempts = GetDelta(stats, ETrafficCounter.SPAWN_ATTEMPTS);
+        int spawned = GetDelta(stats, ETrafficCounter.SPAWNED);
+        int recycled = GetDelta(stats, ETrafficCounter.RECYCLED);
+        int despawned = GetDelta(stats, ETrafficCounter.DESPAWNED);
+
+        float successRate;
+        if (attempts > 0)
+        {
+            float succeeded = spawned + recycled;
+            successRate = succeeded / attempts;
+        }
+
+        float ticks = Math.Max(1, m_aLoopMs.Count());
+        float avgActive = m_iActiveSum / ticks;
+
+        string result = "    {\n";
+        result += string.Format("      \"cap\": %1, \"ticks\": %2, \"avgActive\": %3,\n", m_aCaps[m_iStage], m_aLoopMs.Count(), avgActive.ToString(-1, 2));
+        result += string.Format("      \"loopMs\": %1,\n", FormatPercentiles(m_aLoopMs));
+        result += string.Format("      \"pipelineMs\": %1,\n", FormatPercentiles(m_aPipelineMs));
+        result += string.Format("      \"frameMs\": %1,\n", FormatPercentiles(m_aFrameMs));
+        result += string.Format("      \"spawnAttempts\": %1, \"spawnSuccessRate\": %2, \"searchFailures\": %3, \"buildFailures\": %4,\n",
+            attempts, successRate.ToString(-1, 3), GetDelta(stats, ETrafficCounter.SPAWN_SEARCH_FAILURES), GetDelta(stats, ETrafficCounter.SPAWN_JOB_FAILURES));
+        result += string.Format("      \"traces\": %1, \"waypoints\": %2,\n", GetDelta(stats, ETrafficCounter.TRACES), GetDelta(stats, ETrafficCounter.WAYPOINTS));
+        result += string.Format("      \"churn\": { \"spawned\": %1, \"recycled\": %2, \"despawned\": %3, \"legsChained\": %4 }\n", spawned, recycled, despawned, GetDelta(stats, ETrafficCounter.LEGS));
+        result += "    }";
+        m_aStageResults.Insert(result);
+
+        Print(string.Format("[TRAFFIC BENCHMARK] Cap %1 done: loop p95 %2 ms, frame p95 %3 ms, spawn success %4",
+            m_aCaps[m_iStage], Percentile(m_aLoopMs, 0.95), Percentile(m_aFrameMs, 0.95), successRate.ToString(-1, 3)), LogLevel.NORMAL);
+    }
+
+    protected void Finish()
+    {
+        m_bFinished = true;
+        string path = WriteResults();
+        Print(string.Format("[TRAFFIC BENCHMARK] Finished, results in %1", path), LogLevel.NORMAL);
+
+        SCR_TrafficRandom.Reset();
+
+        if (m_bQuitWhenDone)
+            GetGame().RequestClose();
+    }
+
+    protected string WriteResults()
+    {
+        FileIO.MakeDirectory(RESULTS_DIRECTORY);
+        string path = string.Format("%1/benchmark_%2.json", RESULTS_DIRECTORY, m_iSeed);
+
+        FileHandle file = FileIO.OpenFile(path, FileMode.WRITE);
+        if (!file)
+        {
+            Print(string.Format("[TRAFFIC BENCHMARK] Could not write results file %1", path), LogLevel.WARNING);
+            return path;
+        }
+
+        file.WriteLine("{");
+        file.WriteLine(string.Format("  \"world\": \"%1\",", GetGame().GetWorldFile()));
+        file.WriteLine(string.Format("  \"seed\": %1, \"observers\": %2, \"warmupSeconds\": %3, \"stageSeconds\": %4,",
+            m_iSeed, m_iObserverCount, m_iWarmupTicks, m_iMeasureTicks));
+        file.WriteLine("  \"stages\": [");
+
+        foreach (int i, string stage : m_aStageResults)
+        {
+            if (i < m_aStageResults.Count() - 1)
+                file.WriteLine(stage + ",");
+            else
+                file.WriteLine(stage);
+        }
+
+        file.WriteLine("  ]");
+        file.WriteLine("}");
+        file.Close();
+        return path;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected int GetDelta(SCR_TrafficStats stats, ETrafficCounter counter)
+    {
+        return stats.GetTotal(counter) - m_aCounterStart[counter];
+    }
+
+    protected string FormatPercentiles(array<float> samples)
+    {
+        return string.Format("{ \"p50\": %1, \"p95\": %2, \"p99\": %3, \"max\": %4 }",
+            Percentile(samples, 0.5), Percentile(samples, 0.95), Percentile(samples, 0.99), Percentile(samples, 1.0));
+    }
+
+    // Nearest-rank percentile; sorts a copy so the samples keep their tick order
+    protected float Percentile(array<float> samples, float fraction)
+    {
+        if (samples.IsEmpty())
+            return 0;
+
+        array<float> sorted = {};
+        sorted.Copy(samples);
+        sorted.Sort();
+
+        int rank = Math.Ceil(fraction * sorted.Count());
+        return sorted[Math.ClampInt(rank - 1, 0, sorted.Count() - 1)];
+    }
+
+    // "5,10,20" -> {5, 10, 20}; entries that are not positive numbers are skipped
+    protected void ParseCaps(string caps)
+    {
+        array<string> parts = {};
+        caps.Split(",", parts, true);
+
+        foreach (string part : parts)
+        {
+            part.TrimInPlace();
+            int cap = part.ToInt();
+            if (cap > 0)
+                m_aCaps.Insert(cap);
+        }
+    }
+}
@@ -0,0 +1,333 @@
+// ------------------------------------------------------------------------------------------------
+// Splits the vehicle cap between groups of players that are far apart. Players within one despawn
+// range of each other form a cluster; each cluster's share of the cap is weighted by the
+// spawnable road around its players and, sub-linearly, by how many players it has. Spawns search
+// the clusters furthest below their share first, and a full budget is rebalanced by shedding from
+// a cluster above its share while another is below it.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficClusterBalancer
+{
+    // Each player beyond the first adds this fraction of the cluster's road weight
+    protected const float EXTRA_PLAYER_WEIGHT = 0.5;
+    // Road density is cached per cell; the road index does not change during a session
+    protected const float DENSITY_CELL_SIZE = 500.0;
+    // Ticks without rebalancing after a spawn had to fall back to a cluster at its share
+    protected const int REBALANCE_HOLD_TICKS = 30;
+
+    protected SCR_TrafficRoadIndex m_RoadIndex;
+    protected float m_fRange;
+    protected int m_iRebalanceHold;
+
+    // Per snapshot index
+    protected ref array<int> m_aPlayerClusters = {};
+    protected ref array<int> m_aParents = {};
+
+    // Per cluster
+    protected ref array<int> m_aClusterPlayers = {};
+    protected ref array<float> m_aClusterWeights = {};
+    protected ref array<int> m_aClusterShares = {};
+    protected ref array<int> m_aClusterUnits = {};
+    protected ref array<float> m_aRemainders = {};
+
+    protected ref SCR_TrafficSpatialGrid m_DensityCells = new SCR_TrafficSpatialGrid(DENSITY_CELL_SIZE);
+    protected ref map<int, int> m_mDensityCache = new map<int, int>();
+    protected ref array<int> m_aQueryBuffer = {};
+    protected ref array<vector> m_aJobPositions = {};
+
+    // ------------------------------------------------------------------------------------------------
+    void SCR_TrafficClusterBalancer(SCR_TrafficRoadIndex roadIndex)
+    {
+        m_RoadIndex = roadIndex;
+    }
+
+    // Despawn range: links players into clusters and is the radius road density is measured in
+    void SetRange(float range)
+    {
+        m_fRange = range;
+        m_mDensityCache.Clear();
+    }
+
+    void Clear()
+    {
+        m_aPlayerClusters.Clear();
+        m_aClusterPlayers.Clear();
+        m_aClusterWeights.Clear();
+        m_aClusterShares.Clear();
+        m_aClusterUnits.Clear();
+        m_mDensityCache.Clear();
+        m_iRebalanceHold = 0;
+    }
+
+    int GetClusterCount()
+    {
+        return m_aClusterPlayers.Count();
+    }
+
+    // Regroups the snapshot's players, splits cap between the clusters and counts the cars and
+    // in-flight spawns each one already has. Sets m_iCluster on every unit.
+    void Update(SCR_TrafficPlayerSnapshot snapshot, array<ref SCR_TrafficUnit> units, SCR_TrafficSpawnPipeline pipeline, int cap)
+    {
+        if (m_iRebalanceHold > 0)
+            m_iRebalanceHold--;
+
+        BuildClusters(snapshot);
+        ComputeShares(cap);
+
+        m_aClusterUnits.Clear();
+        for (int c = 0; c < m_aClusterPlayers.Count(); c++)
+            m_aClusterUnits.Insert(0);
+
+        foreach (SCR_TrafficUnit unit : units)
+        {
+            unit.m_iCluster = -1;
+            if (!unit.m_Vehicle)
+                continue;
+
+            unit.m_iCluster = GetClusterAt(snapshot, unit.m_Vehicle.GetOrigin());
+            if (unit.m_iCluster != -1)
+                m_aClusterUnits[unit.m_iCluster] = m_aClusterUnits[unit.m_iCluster] + 1;
+        }
+
+        m_aJobPositions.Clear();
+        pipeline.GetJobPositions(m_aJobPositions);
+        foreach (vector pos : m_aJobPositions)
+        {
+            int cluster = GetClusterAt(snapshot, pos);
+            if (cluster != -1)
+                m_aClusterUnits[cluster] = m_aClusterUnits[cluster] + 1;
+        }
+    }
+
+    // Cluster of the player nearest to pos within range, or -1
+    int GetClusterAt(SCR_TrafficPlayerSnapshot snapshot, vector pos)
+    {
+        int player = snapshot.GetNearestPlayerIndex(pos, m_fRange);
+        if (player == -1 || player >= m_aPlayerClusters.Count())
+            return -1;
+
+        return m_aPlayerClusters[player];
+    }
+
+    // Snapshot indices to search for a spawn: players of clusters below their share, largest
+    // deficit first, then the rest so an unreachable share does not leave the budget unused.
+    void GetSpawnOrder(notnull array<int> outPlayers)
+    {
+        array<int> order = {};
+        for (int c = 0; c < m_aClusterPlayers.Count(); c++)
+        {
+            int deficit = GetDeficit(c);
+            int at = 0;
+            while (at < order.Count() && GetDeficit(order[at]) >= deficit)
+                at++;
+
+            order.InsertAt(c, at);
+        }
+
+        array<int> members = {};
+        foreach (int cluster : order)
+        {
+            members.Clear();
+            foreach (int player, int playerCluster : m_aPlayerClusters)
+            {
+                if (playerCluster == cluster)
+                    members.Insert(player);
+            }
+
+            // Random start so repeated spawns do not always search around the same player first
+            int count = members.Count();
+            int offset = SCR_TrafficRandom.RandomInt(0, count);
+            for (int i = 0; i < count; i++)
+                outPlayers.Insert(members[(offset + i) % count]);
+        }
+    }
+
+    // Called after a successful spawn search so the next decisions this tick see the new car
+    void OnSpawned(SCR_TrafficPlayerSnapshot snapshot, vector pos)
+    {
+        int cluster = GetClusterAt(snapshot, pos);
+        if (cluster == -1)
+            return;
+
+        // The car went to a cluster that did not need it: the short ones found nothing, so
+        // shedding towards them now would only churn
+        if (GetDeficit(cluster) <= 0)
+            m_iRebalanceHold = REBALANCE_HOLD_TICKS;
+
+        m_aClusterUnits[cluster] = m_aClusterUnits[cluster] + 1;
+    }
+
+    // Cluster at least one car over its share while another is at least one short, or -1
+    int GetRebalanceSource()
+    {
+        if (m_iRebalanceHold > 0)
+            return -1;
+
+        bool anyShort;
+        int source = -1;
+        int sourceExcess = 0;
+        for (int c = 0; c < m_aClusterPlayers.Count(); c++)
+        {
+            int excess = -GetDeficit(c);
+            if (excess <= -1)
+                anyShort = true;
+
+            if (excess > sourceExcess)
+            {
+                sourceExcess = excess;
+                source = c;
+            }
+        }
+
+        if (!anyShort)
+            return -1;
+
+        return source;
+    }
+
+    // One line per cluster for the admin overlay
+    string FormatSummary()
+    {
+        string text = string.Format("Clusters: %1", m_aClusterPlayers.Count());
+        for (int c = 0; c < m_aClusterPlayers.Count(); c++)
+            text += string.Format(" | #%1 %2p %3/%4", c + 1, m_aClusterPlayers[c], m_aClusterUnits[c], m_aClusterShares[c]);
+
+        return text;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected int GetDeficit(int cluster)
+    {
+        return m_aClusterShares[cluster] - m_aClusterUnits[cluster];
+    }
+
+    // Union-find over players closer than the range; clusters are numbered in snapshot order
+    protected void BuildClusters(SCR_TrafficPlayerSnapshot snapshot)
+    {
+        int count = snapshot.GetCount();
+
+        m_aParents.Clear();
+        for (int i = 0; i < count; i++)
+            m_aParents.Insert(i);
+
+        for (int i = 0; i < count; i++)
+        {
+            m_aQueryBuffer.Clear();
+            snapshot.GetPlayersWithin(snapshot.GetPosition(i), m_fRange, m_aQueryBuffer);
+            foreach (int other : m_aQueryBuffer)
+            {
+                int rootA = FindRoot(i);
+                int rootB = FindRoot(other);
+                if (rootA != rootB)
+                    m_aParents[rootB] = rootA;
+            }
+        }
+
+        m_aPlayerClusters.Clear();
+        m_aClusterPlayers.Clear();
+        m_aClusterWeights.Clear();
+
+        array<int> rootClusters = {};
+        for (int i = 0; i < count; i++)
+            rootClusters.Insert(-1);
+
+        for (int i = 0; i < count; i++)
+        {
+            int root = FindRoot(i);
+            int cluster = rootClusters[root];
+            if (cluster == -1)
+            {
+                cluster = m_aClusterPlayers.Count();
+                rootClusters[root] = cluster;
+                m_aClusterPlayers.Insert(0);
+                m_aClusterWeights.Insert(0);
+            }
+
+            m_aPlayerClusters.Insert(cluster);
+            m_aClusterPlayers[cluster] = m_aClusterPlayers[cluster] + 1;
+            m_aClusterWeights[cluster] = m_aClusterWeights[cluster] + GetRoadDensity(snapshot.GetPosition(i));
+        }
+
+        // Weight = average road density of the members, scaled up for each extra player
+        for (int c = 0; c < m_aClusterPlayers.Count(); c++)
+        {
+            float players = m_aClusterPlayers[c];
+            m_aClusterWeights[c] = m_aClusterWeights[c] / players * (1 + EXTRA_PLAYER_WEIGHT * (players - 1));
+        }
+    }
+
+    protected int FindRoot(int index)
+    {
+        while (m_aParents[index] != index)
+        {
+            m_aParents[index] = m_aParents[m_aParents[index]];
+            index = m_aParents[index];
+        }
+
+        return index;
+    }
+
+    // Largest-remainder split, so the shares always add up to the cap
+    protected void ComputeShares(int cap)
+    {
+        m_aClusterShares.Clear();
+        m_aRemainders.Clear();
+
+        float totalWeight = 0;
+        foreach (float weight : m_aClusterWeights)
+            totalWeight += weight;
+
+        int assigned = 0;
+        foreach (float weight : m_aClusterWeights)
+        {
+            float exact = 0;
+            if (totalWeight > 0)
+                exact = cap * weight / totalWeight;
+
+            int share = Math.Floor(exact);
+            m_aClusterShares.Insert(share);
+            m_aRemainders.Insert(exact - share);
+            assigned += share;
+        }
+
+        // Without any road near players every share stays 0
+        if (totalWeight <= 0)
+            return;
+
+        for (int left = cap - assigned; left > 0; left--)
+        {
+            int best = -1;
+            float bestRemainder = -1;
+            foreach (int c, float remainder : m_aRemainders)
+            {
+                if (remainder > bestRemainder)
+                {
+                    bestRemainder = remainder;
+                    best = c;
+                }
+            }
+
+            if (best == -1)
+                break;
+
+            m_aClusterShares[best] = m_aClusterShares[best] + 1;
+            m_aRemainders[best] = -1;
+        }
+    }
+
+    // Spawnable road points within range of the centre of pos's cell
+    protected int GetRoadDensity(vector pos)
+    {
+        int cx = m_DensityCells.GetCellX(pos);
+        int cz = m_DensityCells.GetCellZ(pos);
+        int key = SCR_TrafficSpatialGrid.MakeKey(cx, cz);
+
+        int density;
+        if (m_mDensityCache.Find(key, density))
+            return density;
+
+        vector center = Vector((cx + 0.5) * DENSITY_CELL_SIZE, 0, (cz + 0.5) * DENSITY_CELL_SIZE);
+        density = m_RoadIndex.CountSpawnablePoints(center, m_fRange);
+        m_mDensityCache.Insert(key, density);
+        return density;
+    }
+}
@@ -0,0 +1,137 @@
+// ------------------------------------------------------------------------------------------------
+// Scales the effective vehicle cap and spawn rate with server load. Frame time (smoothed) and
+// the share of the AI limit in use are sampled every traffic tick; the cap steps down while
+// either is above its high threshold and steps back up only once both are under their low
+// thresholds, so it doesn't oscillate around a single value.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficDensityGovernor
+{
+    protected const float FRAME_TIME_SMOOTHING = 0.2;
+    protected const float AI_LOAD_HIGH = 0.9;
+    protected const float AI_LOAD_LOW = 0.75;
+    protected const int ADJUST_INTERVAL_TICKS = 5;
+    protected const int MAX_SPAWN_COOLDOWN_TICKS = 5;
+
+    protected bool m_bEnabled;
+    protected int m_iMinCap;
+    protected int m_iMaxCap;
+    protected float m_fHighFrameMs;
+    protected float m_fLowFrameMs;
+
+    protected int m_iEffectiveCap;
+    protected float m_fSmoothedFrameMs;
+    protected float m_fAILoad;
+    protected int m_iTicksSinceAdjust;
+    protected int m_iSpawnCooldown;
+    protected string m_sLastReason = "not adjusted";
+
+    // ------------------------------------------------------------------------------------------------
+    void Configure(bool enabled, int minCap, int maxCap, float highFrameMs, float lowFrameMs)
+    {
+        m_bEnabled = enabled;
+        m_iMaxCap = Math.Max(0, maxCap);
+        m_iMinCap = Math.Clamp(minCap, 0, m_iMaxCap);
+        m_fHighFrameMs = highFrameMs;
+        m_fLowFrameMs = Math.Min(lowFrameMs, highFrameMs);
+        m_iEffectiveCap = m_iMaxCap;
+        m_fSmoothedFrameMs = 0;
+        m_iTicksSinceAdjust = 0;
+        m_iSpawnCooldown = 0;
+    }
+
+    bool IsEnabled()
+    {
+        return m_bEnabled;
+    }
+
+    int GetEffectiveCap()
+    {
+        return m_iEffectiveCap;
+    }
+
+    float GetFrameTimeMs()
+    {
+        return m_fSmoothedFrameMs;
+    }
+
+    float GetAILoad()
+    {
+        return m_fAILoad;
+    }
+
+    // Why the cap was last changed, for admins wondering where the traffic went
+    string GetLastReason()
+    {
+        return m_sLastReason;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Called once per traffic tick
+    void Update()
+    {
+        if (!m_bEnabled)
+            return;
+
+        if (m_iSpawnCooldown > 0)
+            m_iSpawnCooldown--;
+
+        float frameMs = GetGame().GetWorld().GetTimeSlice() * 1000.0;
+        if (m_fSmoothedFrameMs <= 0)
+            m_fSmoothedFrameMs = frameMs;
+        else
+            m_fSmoothedFrameMs = Math.Lerp(m_fSmoothedFrameMs, frameMs, FRAME_TIME_SMOOTHING);
+
+        m_fAILoad = SampleAILoad();
+
+        m_iTicksSinceAdjust++;
+        if (m_iTicksSinceAdjust < ADJUST_INTERVAL_TICKS)
+            return;
+
+        int previousCap = m_iEffectiveCap;
+        if (m_fSmoothedFrameMs > m_fHighFrameMs || m_fAILoad > AI_LOAD_HIGH)
+            m_iEffectiveCap = Math.Max(m_iMinCap, m_iEffectiveCap - 1);
+        else if (m_fSmoothedFrameMs < m_fLowFrameMs && m_fAILoad < AI_LOAD_LOW)
+            m_iEffectiveCap = Math.Min(m_iMaxCap, m_iEffectiveCap + 1);
+
+        if (m_iEffectiveCap == previousCap)
+            return;
+
+        m_iTicksSinceAdjust = 0;
+        m_sLastReason = string.Format("frame %1 ms (high %2, low %3), AI load %4",
+            m_fSmoothedFrameMs.ToString(-1, 1), m_fHighFrameMs, m_fLowFrameMs, m_fAILoad.ToString(-1, 2));
+
+        Print(string.Format("[TRAFFIC] Density cap %1 -> %2: %3", previousCap, m_iEffectiveCap, m_sLastReason), LogLevel.NORMAL);
+    }
+
+    // Spawns are spaced out further the lower the cap sits in [min, max]
+    bool ConsumeSpawnSlot()
+    {
+        if (!m_bEnabled)
+            return true;
+
+        if (m_iSpawnCooldown > 0)
+            return false;
+
+        float headroom = 1.0;
+        float span = m_iMaxCap - m_iMinCap;
+        if (span > 0)
+            headroom = (m_iEffectiveCap - m_iMinCap) / span;
+
+        m_iSpawnCooldown = Math.Round((1.0 - headroom) * MAX_SPAWN_COOLDOWN_TICKS);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected float SampleAILoad()
+    {
+        AIWorld aiWorld = GetGame().GetAIWorld();
+        if (!aiWorld)
+            return 0;
+
+        float limit = aiWorld.GetLimitOfActiveAIs();
+        if (limit <= 0)
+            return 0;
+
+        return aiWorld.GetCurrentAmountOfLimitedAIs() / limit;
+    }
+}
@@ -0,0 +1,105 @@
+// ------------------------------------------------------------------------------------------------
+// Driver AI level of detail. Instead of pinning every driver at full LOD, each unit is placed in
+// a band from its nearest-player distance (taken from the tick's player snapshot): full near
+// players, reduced in the middle, minimal towards the despawn edge. A threat event pins nearby
+// drivers at full LOD for a while so they can actually react.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficDriverLOD
+{
+    // Engine AI LOD values: 0 is full simulation, higher values skip more perception and planning
+    static const int LOD_FULL = 0;
+    static const int LOD_REDUCED = 5;
+    static const int LOD_MINIMAL = 9;
+
+    // Moving to a cheaper band requires this much extra distance, so units on a boundary don't flap
+    protected const float BAND_HYSTERESIS = 1.1;
+    protected const float THREAT_PIN_DURATION = 60.0;
+
+    protected float m_fFullRange = 600.0;
+    protected float m_fReducedRange = 1500.0;
+
+    // ------------------------------------------------------------------------------------------------
+    void Configure(float fullRange, float reducedRange)
+    {
+        m_fFullRange = fullRange;
+        m_fReducedRange = Math.Max(fullRange, reducedRange);
+    }
+
+    // Re-evaluates every unit's band and only touches the agent when the band changes
+    void Update(array<ref SCR_TrafficUnit> units, SCR_TrafficPlayerSnapshot snapshot)
+    {
+        float now = GetGame().GetWorld().GetWorldTime() / 1000.0;
+        float searchRadius = m_fReducedRange * BAND_HYSTERESIS;
+
+        foreach (SCR_TrafficUnit unit : units)
+        {
+            if (!unit.m_Vehicle)
+                continue;
+
+            int lod = LOD_FULL;
+            if (now >= unit.m_fLODPinnedUntil)
+            {
+                float dist = snapshot.GetNearestPlayerDistance(unit.m_Vehicle.GetOrigin(), searchRadius);
+                lod = GetBand(dist, unit.m_iAILOD);
+            }
+
+            Apply(unit, lod);
+        }
+    }
+
+    // Pins the given units (already filtered to the threat area by the caller) at full LOD
+    void Pin(array<SCR_TrafficUnit> units)
+    {
+        float pinnedUntil = GetGame().GetWorld().GetWorldTime() / 1000.0 + THREAT_PIN_DURATION;
+
+        foreach (SCR_TrafficUnit unit : units)
+        {
+            unit.m_fLODPinnedUntil = pinnedUntil;
+            Apply(unit, LOD_FULL);
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected int GetBand(float dist, int currentLOD)
+    {
+        float fullRange = m_fFullRange;
+        float reducedRange = m_fReducedRange;
+
+        // Stretch the band the unit is already in
+        if (currentLOD == LOD_FULL)
+            fullRange *= BAND_HYSTERESIS;
+        else if (currentLOD == LOD_REDUCED)
+            reducedRange *= BAND_HYSTERESIS;
+
+        if (dist <= fullRange)
+            return LOD_FULL;
+
+        if (dist <= reducedRange)
+            return LOD_REDUCED;
+
+        return LOD_MINIMAL;
+    }
+
+    void Apply(SCR_TrafficUnit unit, int lod)
+    {
+        if (unit.m_iAILOD == lod)
+            return;
+
+        AIAgent agent = unit.GetAgent();
+        if (!agent)
+            return;
+
+        if (lod == LOD_FULL)
+        {
+            agent.PreventMaxLOD();
+            agent.SetPermanentLOD(LOD_FULL);
+        }
+        else
+        {
+            agent.AllowMaxLOD();
+            agent.SetPermanentLOD(lod);
+        }
+
+        unit.m_iAILOD = lod;
+    }
+}
@@ -0,0 +1,226 @@
+// Ordered by severity; an incident reports the most severe type merged into it
+enum ETrafficCivilianEvent
+{
+    GUNFIGHT,
+    PANIC,
+    KILLED
+}
+
+enum ETrafficIncidentState
+{
+    OPENED,
+    UPDATED,
+    CLOSED
+}
+
+// ------------------------------------------------------------------------------------------------
+// One civilian event as raised by SCR_CivilianTrafficObserver
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficCivilianEvent : Managed
+{
+    ETrafficCivilianEvent m_eType;
+    vector m_vPosition;
+    IEntity m_Source;
+    // 0..1: alerted < vigilant < panic < killed
+    float m_fSeverity;
+    // World time in seconds
+    float m_fTimestamp;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Events close together in space and time, merged. The position is that of the first event, so an
+// incident does not drift across town while a fight moves.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficIncident : Managed
+{
+    int m_iId;
+    ETrafficIncidentState m_eState;
+    ETrafficCivilianEvent m_eType;
+    vector m_vPosition;
+    float m_fSeverity;
+    float m_fStartTime;
+    float m_fLastTime;
+    int m_iCount;
+    IEntity m_LastSource;
+
+    // Bookkeeping for rate-limited UPDATED deliveries
+    float m_fDeliveredAt;
+    int m_iDeliveredCount;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Typed civilian events with two delivery modes. OnEvent gets every event as raised; OnIncident
+// gets incidents: once when one opens, again when its type or severity escalates or (at most once per window)
+// when more events have merged, and once when no event has arrived for a window. Listeners that
+// only need "something is going on here" should use OnIncident, which stays at a handful of calls
+// however many civilians report the same fight.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficEventBus
+{
+    static const float DEFAULT_INCIDENT_RADIUS = 150.0;
+    static const float DEFAULT_INCIDENT_WINDOW = 10.0;
+    protected const int SWEEP_INTERVAL_MS = 1000;
+
+    ref ScriptInvoker<SCR_TrafficCivilianEvent> OnEvent = new ScriptInvoker<SCR_TrafficCivilianEvent>();
+    ref ScriptInvoker<SCR_TrafficIncident> OnIncident = new ScriptInvoker<SCR_TrafficIncident>();
+
+    protected float m_fRadius = DEFAULT_INCIDENT_RADIUS;
+    protected float m_fWindow = DEFAULT_INCIDENT_WINDOW;
+
+    protected ref array<ref SCR_TrafficIncident> m_aOpen = {};
+    protected int m_iNextIncidentId;
+    protected bool m_bSweeping;
+
+    // Lifetime counters
+    protected int m_iEventsTotal;
+    protected int m_iIncidentsTotal;
+
+    // ------------------------------------------------------------------------------------------------
+    // radius in metres, window in seconds
+    void Configure(float radius, float window)
+    {
+        m_fRadius = Math.Max(0, radius);
+        m_fWindow = Math.Max(1, window);
+    }
+
+    float GetIncidentRadius()
+    {
+        return m_fRadius;
+    }
+
+    int GetEventsTotal()
+    {
+        return m_iEventsTotal;
+    }
+
+    int GetIncidentsTotal()
+    {
+        return m_iIncidentsTotal;
+    }
+
+    // Delivers the event raw, to the legacy string hook and into the incident it belongs to
+    void Raise(ETrafficCivilianEvent type, IEntity source, float severity)
+    {
+        if (!source)
+            return;
+
+        SCR_TrafficCivilianEvent evt = new SCR_TrafficCivilianEvent();
+        evt.m_eType = type;
+        evt.m_vPosition = source.GetOrigin();
+        evt.m_Source = source;
+        evt.m_fSeverity = Math.Clamp(severity, 0, 1);
+        evt.m_fTimestamp = GetGame().GetWorld().GetWorldTime() / 1000.0;
+        m_iEventsTotal++;
+
+        OnEvent.Invoke(evt);
+        SCR_TrafficEvents.OnCivilianEvent.Invoke(evt.m_vPosition, GetLegacyName(type));
+        Aggregate(evt);
+    }
+
+    // Drops open incidents without closing them, e.g. when the mission ends
+    void Clear()
+    {
+        m_aOpen.Clear();
+        if (m_bSweeping)
+        {
+            ScriptCallQueue queue = GetGame().GetCallqueue();
+            if (queue)
+                queue.Remove(Sweep);
+
+            m_bSweeping = false;
+        }
+    }
+
+    // Name used by SCR_TrafficEvents.OnCivilianEvent; panic was always reported as a gunfight there
+    static string GetLegacyName(ETrafficCivilianEvent type)
+    {
+        if (type == ETrafficCivilianEvent.KILLED)
+            return "killed";
+
+        return "gunfight";
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected void Aggregate(SCR_TrafficCivilianEvent evt)
+    {
+        float radiusSq = m_fRadius * m_fRadius;
+        foreach (SCR_TrafficIncident open : m_aOpen)
+        {
+            if (vector.DistanceSqXZ(open.m_vPosition, evt.m_vPosition) > radiusSq)
+                continue;
+
+            open.m_iCount++;
+            open.m_fLastTime = evt.m_fTimestamp;
+            open.m_LastSource = evt.m_Source;
+
+            // Escalation, in type or severity, is delivered right away; more of the same waits for
+            // the sweep. A gunfight going from alerted to vigilant must reach listeners gated on
+            // severity now, not a window later.
+            bool escalated = evt.m_eType > open.m_eType || evt.m_fSeverity > open.m_fSeverity;
+            open.m_fSeverity = Math.Max(open.m_fSeverity, evt.m_fSeverity);
+            if (evt.m_eType > open.m_eType)
+                open.m_eType = evt.m_eType;
+
+            if (escalated)
+                Deliver(open, ETrafficIncidentState.UPDATED, evt.m_fTimestamp);
+
+            return;
+        }
+
+        SCR_TrafficIncident incident = new SCR_TrafficIncident();
+        incident.m_iId = m_iNextIncidentId;
+        m_iNextIncidentId++;
+        incident.m_eType = evt.m_eType;
+        incident.m_vPosition = evt.m_vPosition;
+        incident.m_fSeverity = evt.m_fSeverity;
+        incident.m_fStartTime = evt.m_fTimestamp;
+        incident.m_fLastTime = evt.m_fTimestamp;
+        incident.m_iCount = 1;
+        incident.m_LastSource = evt.m_Source;
+        m_aOpen.Insert(incident);
+        m_iIncidentsTotal++;
+
+        Deliver(incident, ETrafficIncidentState.OPENED, evt.m_fTimestamp);
+
+        if (!m_bSweeping)
+        {
+            m_bSweeping = true;
+            GetGame().GetCallqueue().CallLater(Sweep, SWEEP_INTERVAL_MS, true);
+        }
+    }
+
+    // Closes quiet incidents and reports busy ones; stops itself once nothing is open
+    protected void Sweep()
+    {
+        float now = GetGame().GetWorld().GetWorldTime() / 1000.0;
+
+        for (int i = m_aOpen.Count() - 1; i >= 0; i--)
+        {
+            SCR_TrafficIncident incident = m_aOpen[i];
+            if (now - incident.m_fLastTime > m_fWindow)
+            {
+                // The local keeps the incident alive for the CLOSED delivery
+                m_aOpen.RemoveOrdered(i);
+                Deliver(incident, ETrafficIncidentState.CLOSED, now);
+                continue;
+            }
+
+            if (incident.m_iCount > incident.m_iDeliveredCount && now - incident.m_fDeliveredAt >= m_fWindow)
+                Deliver(incident, ETrafficIncidentState.UPDATED, now);
+        }
+
+        if (m_aOpen.IsEmpty())
+        {
+            GetGame().GetCallqueue().Remove(Sweep);
+            m_bSweeping = false;
+        }
+    }
+
+    protected void Deliver(SCR_TrafficIncident incident, ETrafficIncidentState state, float now)
+    {
+        incident.m_eState = state;
+        incident.m_fDeliveredAt = now;
+        incident.m_iDeliveredCount = incident.m_iCount;
+        OnIncident.Invoke(incident);
+    }
+}
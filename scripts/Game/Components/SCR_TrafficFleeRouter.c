@@ -0,0 +1,223 @@
+// ------------------------------------------------------------------------------------------------
+// Escape targets for panicking drivers, taken from the road index instead of a point straight
+// behind the car (often off-road, in water or inside a building). For each road point, the road is
+// walked about FLEE_DISTANCE in both directions, continuing through junctions on the branch that
+// leads furthest from the start; the two end points are its escape targets. Targets and their
+// route check against the road network are computed on first use and cached per point, so a panic
+// costs a lookup rather than a path search.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficEscapeTargets : Managed
+{
+    ref array<int> m_aPoints = {};
+    // Reachable position reported by the road network; only valid when m_aValidated is 1
+    ref array<vector> m_aReachable = {};
+    // -1 not checked yet, 0 no route, 1 route found
+    ref array<int> m_aValidated = {};
+}
+
+class SCR_TrafficFleeRouter
+{
+    protected const float FLEE_DISTANCE = 500.0;
+    protected const float SNAP_RADIUS = 150.0;
+    protected const float ROUTE_CHECK_RADIUS = 20.0;
+
+    protected SCR_TrafficRoadIndex m_RoadIndex;
+    protected ref map<int, ref SCR_TrafficEscapeTargets> m_mTargets = new map<int, ref SCR_TrafficEscapeTargets>();
+    protected ref array<int> m_aJunctionBuffer = {};
+
+    // Lifetime counters
+    protected int m_iLookups;
+    protected int m_iCacheHits;
+
+    // ------------------------------------------------------------------------------------------------
+    void SCR_TrafficFleeRouter(SCR_TrafficRoadIndex roadIndex)
+    {
+        m_RoadIndex = roadIndex;
+    }
+
+    void Clear()
+    {
+        m_mTargets.Clear();
+    }
+
+    int GetCachedCount()
+    {
+        return m_mTargets.Count();
+    }
+
+    int GetLookups()
+    {
+        return m_iLookups;
+    }
+
+    int GetCacheHits()
+    {
+        return m_iCacheHits;
+    }
+
+    // Road position to flee to from carPos, preferring the escape target that leads most directly
+    // away from threatPos and has a route. False when the car is not near an indexed road.
+    bool FindEscapePosition(vector carPos, vector threatPos, out vector outPos)
+    {
+        if (!m_RoadIndex.IsBuilt())
+            return false;
+
+        int point = m_RoadIndex.FindNearestPoint(carPos, SNAP_RADIUS);
+        if (point == -1)
+            return false;
+
+        m_iLookups++;
+        SCR_TrafficEscapeTargets targets = GetTargets(point);
+        if (targets.m_aPoints.IsEmpty())
+            return false;
+
+        vector away = carPos - threatPos;
+        away[1] = 0;
+        away.Normalize();
+
+        // Best first; each candidate's route is only checked when it is the best one left
+        array<int> order = {};
+        array<float> scores = {};
+        foreach (int i, int target : targets.m_aPoints)
+        {
+            vector toTarget = m_RoadIndex.GetPosition(target) - carPos;
+            toTarget[1] = 0;
+            toTarget.Normalize();
+
+            float score = vector.Dot(toTarget, away);
+            int at = 0;
+            while (at < scores.Count() && scores[at] >= score)
+                at++;
+
+            order.InsertAt(i, at);
+            scores.InsertAt(score, at);
+        }
+
+        foreach (int index : order)
+        {
+            if (Validate(point, targets, index))
+            {
+                outPos = targets.m_aReachable[index];
+                return true;
+            }
+        }
+
+        // No route confirmed: the best road point is still better than open terrain
+        outPos = m_RoadIndex.GetPosition(targets.m_aPoints[order[0]]);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected SCR_TrafficEscapeTargets GetTargets(int point)
+    {
+        SCR_TrafficEscapeTargets targets = m_mTargets.Get(point);
+        if (targets)
+        {
+            m_iCacheHits++;
+            return targets;
+        }
+
+        targets = new SCR_TrafficEscapeTargets();
+        for (int step = -1; step <= 1; step += 2)
+        {
+            int end = Walk(point, step);
+            if (end == -1 || targets.m_aPoints.Contains(end))
+                continue;
+
+            targets.m_aPoints.Insert(end);
+            targets.m_aReachable.Insert(m_RoadIndex.GetPosition(end));
+            targets.m_aValidated.Insert(-1);
+        }
+
+        m_mTargets.Insert(point, targets);
+        return targets;
+    }
+
+    // Follows the road from start in the given direction for about FLEE_DISTANCE. Returns the last
+    // point reached, or -1 when the road ends right away.
+    protected int Walk(int start, int step)
+    {
+        vector origin = m_RoadIndex.GetPosition(start);
+        int maxSteps = Math.Ceil(FLEE_DISTANCE / SCR_TrafficRoadIndex.GetSampleSpacing()) * 2;
+        float fleeSq = FLEE_DISTANCE * FLEE_DISTANCE;
+
+        int current = start;
+        for (int i = 0; i < maxSteps; i++)
+        {
+            int next = m_RoadIndex.GetNextPointOnRoad(current, step);
+            if (next == -1)
+            {
+                next = TakeJunction(current, origin, step);
+                if (next == -1)
+                    break;
+            }
+
+            current = next;
+            if (vector.DistanceSqXZ(origin, m_RoadIndex.GetPosition(current)) >= fleeSq)
+                break;
+        }
+
+        if (current == start)
+            return -1;
+
+        return current;
+    }
+
+    // At a road end, continues on the connected road whose next point is furthest from origin.
+    // Updates step for the new road and returns the point to move to, or -1 at a dead end.
+    protected int TakeJunction(int pointId, vector origin, inout int step)
+    {
+        m_aJunctionBuffer.Clear();
+        m_RoadIndex.GetConnectedPoints(pointId, m_aJunctionBuffer);
+
+        int best = -1;
+        int bestStep = step;
+        float bestSq = vector.DistanceSqXZ(origin, m_RoadIndex.GetPosition(pointId));
+
+        foreach (int candidate : m_aJunctionBuffer)
+        {
+            for (int candidateStep = -1; candidateStep <= 1; candidateStep += 2)
+            {
+                int ahead = m_RoadIndex.GetNextPointOnRoad(candidate, candidateStep);
+                if (ahead == -1)
+                    continue;
+
+                float distSq = vector.DistanceSqXZ(origin, m_RoadIndex.GetPosition(ahead));
+                if (distSq > bestSq)
+                {
+                    bestSq = distSq;
+                    best = candidate;
+                    bestStep = candidateStep;
+                }
+            }
+        }
+
+        step = bestStep;
+        return best;
+    }
+
+    // Asks the road network once whether the target can be reached from the point; cached
+    protected bool Validate(int point, SCR_TrafficEscapeTargets targets, int index)
+    {
+        if (targets.m_aValidated[index] != -1)
+            return targets.m_aValidated[index] == 1;
+
+        targets.m_aValidated[index] = 0;
+
+        SCR_AIWorld aiWorld = SCR_AIWorld.Cast(GetGame().GetAIWorld());
+        if (!aiWorld)
+            return false;
+
+        RoadNetworkManager roadMgr = aiWorld.GetRoadNetworkManager();
+        if (!roadMgr)
+            return false;
+
+        vector reachable;
+        if (!roadMgr.GetReachableWaypointInRoad(m_RoadIndex.GetPosition(point), m_RoadIndex.GetPosition(targets.m_aPoints[index]), ROUTE_CHECK_RADIUS, reachable))
+            return false;
+
+        targets.m_aValidated[index] = 1;
+        targets.m_aReachable[index] = reachable;
+        return true;
+    }
+}
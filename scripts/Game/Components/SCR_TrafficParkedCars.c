@@ -0,0 +1,472 @@
+enum ETrafficParkedSpotState
+{
+    // No car right now; one is spawned when a player comes near
+    FREE,
+    SPAWNED,
+    // No room for a car here (building, fence, wreck); checked once, on the first spawn
+    BLOCKED,
+    // The car was driven off, entered or deleted by someone else and is no longer ours
+    TAKEN,
+    DESTROYED
+}
+
+// ------------------------------------------------------------------------------------------------
+// Parked cars along town roads, spawned only around players. Spots are generated once from the
+// road index: points in cells where roads are dense (towns) get a spot at the roadside, facing the
+// driving direction of that side. Spots are kept in a world-cell grid; a cell's cars are spawned,
+// one per frame, when a player comes within the parking radius of the cell and deleted when no
+// player is within that radius plus a margin. Each spot remembers its car model and what happened
+// to its car, so a car comes back as the same model and a car taken by a player or destroyed does
+// not reappear.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficParkedCars
+{
+    protected const float CELL_SIZE = 200.0;
+    // Road points a cell needs to count as town; a single road through a cell has about five
+    protected const int TOWN_MIN_POINTS = 15;
+    protected const float ROADSIDE_OFFSET = 5.0;
+    protected const float MIN_SPOT_SPACING = 20.0;
+    protected const int PICK_ATTEMPTS_PER_SPOT = 4;
+    // Free radius a car needs around its spot, and how far it may be shifted to find it
+    protected const float CLEARANCE_RADIUS = 2.5;
+    protected const float CLEARANCE_SEARCH_RADIUS = 2.0;
+    protected const float DESPAWN_MARGIN = 200.0;
+    // A parked car found further than this from its spot was moved by a player
+    protected const float TAKEN_DISTANCE = 10.0;
+    protected const int MAX_SPAWNS_PER_FRAME = 1;
+
+    protected SCR_TrafficRoadIndex m_RoadIndex;
+    protected SCR_TrafficResourceCache m_ResourceCache;
+    protected SCR_TrafficStats m_Stats;
+    protected ref array<ResourceName> m_aPrefabs = {};
+    protected float m_fRadius = 600;
+
+    // Spot table, indexed by spot id
+    protected ref array<vector> m_aSpotPositions = {};
+    protected ref array<vector> m_aSpotDirections = {};
+    protected ref array<int> m_aSpotPrefabs = {};
+    protected ref array<ETrafficParkedSpotState> m_aSpotStates = {};
+    // Only spots in the SPAWNED state have an entry
+    protected ref map<int, Vehicle> m_mSpotVehicles = new map<int, Vehicle>();
+    protected ref array<bool> m_aSpotChecked = {};
+
+    protected ref SCR_TrafficSpatialGrid m_Cells = new SCR_TrafficSpatialGrid(CELL_SIZE);
+    protected ref map<int, bool> m_mActiveCells = new map<int, bool>();
+    protected ref map<int, bool> m_mWantedCells = new map<int, bool>();
+    protected ref map<int, bool> m_mKeptCells = new map<int, bool>();
+    protected ref array<int> m_aCellBuffer = {};
+    protected ref array<int> m_aQueryBuffer = {};
+    protected ref array<IEntity> m_aOccupantBuffer = {};
+
+    // Spot ids waiting for their car, spawned by Pump one per frame
+    protected ref array<int> m_aPending = {};
+    protected bool m_bPumping;
+
+    // Lifetime counters
+    protected int m_iSpawnedTotal;
+    protected int m_iDespawnedTotal;
+    protected int m_iTakenTotal;
+    protected int m_iDestroyedTotal;
+    protected int m_iBlockedTotal;
+
+    // ------------------------------------------------------------------------------------------------
+    void SCR_TrafficParkedCars(SCR_TrafficRoadIndex roadIndex, SCR_TrafficResourceCache resourceCache, SCR_TrafficStats stats)
+    {
+        m_RoadIndex = roadIndex;
+        m_ResourceCache = resourceCache;
+        m_Stats = stats;
+    }
+
+    void ~SCR_TrafficParkedCars()
+    {
+        Clear();
+    }
+
+    // radius in metres: a cell's cars are spawned once a player is this close to the cell
+    void Configure(float radius, notnull array<ResourceName> prefabs)
+    {
+        m_fRadius = Math.Max(CELL_SIZE, radius);
+        m_aPrefabs.Copy(prefabs);
+    }
+
+    bool IsEnabled()
+    {
+        return !m_aSpotStates.IsEmpty();
+    }
+
+    int GetSpotCount()
+    {
+        return m_aSpotStates.Count();
+    }
+
+    int GetSpawnedCount()
+    {
+        return m_mSpotVehicles.Count();
+    }
+
+    int GetSpawnedTotal()
+    {
+        return m_iSpawnedTotal;
+    }
+
+    int GetDespawnedTotal()
+    {
+        return m_iDespawnedTotal;
+    }
+
+    int GetTakenTotal()
+    {
+        return m_iTakenTotal;
+    }
+
+    int GetDestroyedTotal()
+    {
+        return m_iDestroyedTotal;
+    }
+
+    int GetBlockedTotal()
+    {
+        return m_iBlockedTotal;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Places up to count spots along town roads. Returns false when there is nothing to place.
+    bool Generate(int count)
+    {
+        Clear();
+        if (count <= 0 || m_aPrefabs.IsEmpty() || !m_RoadIndex.IsBuilt())
+            return false;
+
+        // Road points per cell; towns are where roads are dense
+        map<int, int> density = new map<int, int>();
+        int points = m_RoadIndex.GetPointCount();
+        for (int i = 0; i < points; i++)
+        {
+            int key = m_Cells.GetKey(m_RoadIndex.GetPosition(i));
+            density.Set(key, density.Get(key) + 1);
+        }
+
+        array<int> candidates = {};
+        for (int point = 0; point < points; point++)
+        {
+            if (density.Get(m_Cells.GetKey(m_RoadIndex.GetPosition(point))) >= TOWN_MIN_POINTS)
+                candidates.Insert(point);
+        }
+
+        if (candidates.IsEmpty())
+            return false;
+
+        int attempts = count * PICK_ATTEMPTS_PER_SPOT;
+        for (int attempt = 0; attempt < attempts && m_aSpotStates.Count() < count; attempt++)
+            AddSpot(candidates[SCR_TrafficRandom.RandomInt(0, candidates.Count())]);
+
+        return !m_aSpotStates.IsEmpty();
+    }
+
+    // Spawns cars in cells players came near and removes them from cells every player has left
+    void Update(SCR_TrafficPlayerSnapshot snapshot)
+    {
+        if (!IsEnabled())
+            return;
+
+        CollectCells(snapshot, m_fRadius, m_mWantedCells);
+        CollectCells(snapshot, m_fRadius + DESPAWN_MARGIN, m_mKeptCells);
+
+        m_aCellBuffer.Clear();
+        foreach (int key, bool active : m_mActiveCells)
+        {
+            if (!m_mKeptCells.Contains(key))
+                m_aCellBuffer.Insert(key);
+        }
+
+        foreach (int left : m_aCellBuffer)
+        {
+            m_mActiveCells.Remove(left);
+            DeactivateCell(left);
+        }
+
+        foreach (int wanted, bool unused : m_mWantedCells)
+        {
+            if (m_mActiveCells.Contains(wanted))
+                continue;
+
+            m_mActiveCells.Insert(wanted, true);
+            ActivateCell(wanted);
+        }
+    }
+
+    // Deletes every car still parked on its spot and forgets all spots
+    void Clear()
+    {
+        ScriptCallQueue queue = GetGame().GetCallqueue();
+        if (queue)
+            queue.Remove(Pump);
+
+        m_bPumping = false;
+
+        foreach (int spot, Vehicle vehicle : m_mSpotVehicles)
+        {
+            if (vehicle && GetLeaveState(spot, vehicle) == ETrafficParkedSpotState.FREE)
+                SCR_EntityHelper.DeleteEntityAndChildren(vehicle);
+        }
+
+        m_mSpotVehicles.Clear();
+        m_aSpotPositions.Clear();
+        m_aSpotDirections.Clear();
+        m_aSpotPrefabs.Clear();
+        m_aSpotStates.Clear();
+        m_aSpotChecked.Clear();
+        m_Cells.Clear();
+        m_mActiveCells.Clear();
+        m_aPending.Clear();
+    }
+
+    // One line for the admin overlay
+    string FormatSummary()
+    {
+        return string.Format("Parked: %1/%2 spawned in %3 cells | %4 pending | %5 taken, %6 destroyed, %7 blocked",
+            m_mSpotVehicles.Count(), m_aSpotStates.Count(), m_mActiveCells.Count(), m_aPending.Count(),
+            m_iTakenTotal, m_iDestroyedTotal, m_iBlockedTotal);
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Adds a spot beside a random side of the road at point, unless it is too close to another
+    protected bool AddSpot(int point)
+    {
+        vector dir = m_RoadIndex.GetDirection(point);
+        dir[1] = 0;
+        if (dir.LengthSq() < 0.0001)
+            return false;
+
+        dir.Normalize();
+
+        // Right-hand side of the driving direction; cars on the other side face the other way
+        vector side = Vector(dir[2], 0, -dir[0]);
+        if (SCR_TrafficRandom.RandomInt(0, 2) == 0)
+        {
+            side = side * -1;
+            dir = dir * -1;
+        }
+
+        vector pos = m_RoadIndex.GetPosition(point) + side * ROADSIDE_OFFSET;
+
+        // Offset onto another road (parallel street, junction): the car would block its lane
+        int nearest = m_RoadIndex.FindNearestPoint(pos, ROADSIDE_OFFSET - 1);
+        if (nearest != -1 && m_RoadIndex.GetRoadId(nearest) != m_RoadIndex.GetRoadId(point))
+            return false;
+
+        m_aQueryBuffer.Clear();
+        m_Cells.Query(pos, MIN_SPOT_SPACING, m_aQueryBuffer);
+        float spacingSq = MIN_SPOT_SPACING * MIN_SPOT_SPACING;
+        foreach (int other : m_aQueryBuffer)
+        {
+            if (vector.DistanceSqXZ(pos, m_aSpotPositions[other]) < spacingSq)
+                return false;
+        }
+
+        BaseWorld world = GetGame().GetWorld();
+        pos[1] = world.GetSurfaceY(pos[0], pos[2]);
+        if (world.IsOcean() && pos[1] < world.GetOceanBaseHeight())
+            return false;
+
+        int spot = m_aSpotPositions.Count();
+        m_aSpotPositions.Insert(pos);
+        m_aSpotDirections.Insert(dir);
+        m_aSpotPrefabs.Insert(SCR_TrafficRandom.RandomInt(0, m_aPrefabs.Count()));
+        m_aSpotStates.Insert(ETrafficParkedSpotState.FREE);
+        m_aSpotChecked.Insert(false);
+        m_Cells.Insert(pos, spot);
+        return true;
+    }
+
+    // Cells holding spots whose nearest edge is within radius of any player
+    protected void CollectCells(SCR_TrafficPlayerSnapshot snapshot, float radius, notnull map<int, bool> outCells)
+    {
+        outCells.Clear();
+        float radiusSq = radius * radius;
+
+        for (int i = 0; i < snapshot.GetCount(); i++)
+        {
+            vector pos = snapshot.GetPosition(i);
+            int minX = m_Cells.GetCellX(pos - Vector(radius, 0, 0));
+            int maxX = m_Cells.GetCellX(pos + Vector(radius, 0, 0));
+            int minZ = m_Cells.GetCellZ(pos - Vector(0, 0, radius));
+            int maxZ = m_Cells.GetCellZ(pos + Vector(0, 0, radius));
+
+            for (int cx = minX; cx <= maxX; cx++)
+            {
+                for (int cz = minZ; cz <= maxZ; cz++)
+                {
+                    int key = SCR_TrafficSpatialGrid.MakeKey(cx, cz);
+                    if (outCells.Contains(key) || !m_Cells.GetCell(key))
+                        continue;
+
+                    float cellX = CELL_SIZE * cx;
+                    float cellZ = CELL_SIZE * cz;
+                    float dx = Math.Max(0, Math.Max(cellX - pos[0], pos[0] - cellX - CELL_SIZE));
+                    float dz = Math.Max(0, Math.Max(cellZ - pos[2], pos[2] - cellZ - CELL_SIZE));
+                    if (dx * dx + dz * dz <= radiusSq)
+                        outCells.Insert(key, true);
+                }
+            }
+        }
+    }
+
+    protected void ActivateCell(int key)
+    {
+        array<int> spots = m_Cells.GetCell(key);
+        if (!spots)
+            return;
+
+        foreach (int spot : spots)
+        {
+            if (m_aSpotStates[spot] == ETrafficParkedSpotState.FREE)
+                m_aPending.Insert(spot);
+        }
+
+        if (!m_bPumping && !m_aPending.IsEmpty())
+        {
+            m_bPumping = true;
+            GetGame().GetCallqueue().CallLater(Pump, 0, true);
+        }
+    }
+
+    protected void DeactivateCell(int key)
+    {
+        array<int> spots = m_Cells.GetCell(key);
+        if (!spots)
+            return;
+
+        foreach (int spot : spots)
+        {
+            if (m_aSpotStates[spot] == ETrafficParkedSpotState.FREE)
+                m_aPending.RemoveItem(spot);
+            else if (m_aSpotStates[spot] == ETrafficParkedSpotState.SPAWNED)
+                Despawn(spot);
+        }
+    }
+
+    // Spawns pending cars, one per frame, and stops itself when the queue is empty. Runs outside
+    // the loop tick, so it is timed as its own phase rather than inside PARKED.
+    protected void Pump()
+    {
+        m_Stats.BeginPhase(ETrafficPhase.PARKED_SPAWNS);
+
+        int spawned = 0;
+        while (spawned < MAX_SPAWNS_PER_FRAME && !m_aPending.IsEmpty())
+        {
+            int last = m_aPending.Count() - 1;
+            int spot = m_aPending[last];
+            m_aPending.Remove(last);
+
+            if (m_aSpotStates[spot] != ETrafficParkedSpotState.FREE)
+                continue;
+
+            if (Spawn(spot))
+                spawned++;
+        }
+
+        m_Stats.EndPhase(ETrafficPhase.PARKED_SPAWNS);
+
+        if (m_aPending.IsEmpty())
+        {
+            GetGame().GetCallqueue().Remove(Pump);
+            m_bPumping = false;
+        }
+    }
+
+    protected bool Spawn(int spot)
+    {
+        // Room for the car is checked on its first spawn only; the shifted position is kept
+        if (!m_aSpotChecked[spot])
+        {
+            m_aSpotChecked[spot] = true;
+
+            vector clearPos;
+            if (!SCR_WorldTools.FindEmptyTerrainPosition(clearPos, m_aSpotPositions[spot], CLEARANCE_SEARCH_RADIUS, CLEARANCE_RADIUS))
+            {
+                m_aSpotStates[spot] = ETrafficParkedSpotState.BLOCKED;
+                m_iBlockedTotal++;
+                return false;
+            }
+
+            m_aSpotPositions[spot] = clearPos;
+        }
+
+        EntitySpawnParams params = new EntitySpawnParams();
+        params.TransformMode = ETransformMode.WORLD;
+        vector up = "0 1 0";
+        Math3D.DirectionAndUpMatrix(m_aSpotDirections[spot], up, params.Transform);
+        params.Transform[3] = m_aSpotPositions[spot];
+        SCR_TerrainHelper.OrientToTerrain(params.Transform);
+
+        ResourceName prefab = m_aPrefabs[m_aSpotPrefabs[spot]];
+        Vehicle vehicle = Vehicle.Cast(GetGame().SpawnEntityPrefab(m_ResourceCache.Get(prefab), GetGame().GetWorld(), params));
+        if (!vehicle)
+        {
+            m_aSpotStates[spot] = ETrafficParkedSpotState.BLOCKED;
+            m_iBlockedTotal++;
+            return false;
+        }
+
+        CarControllerComponent carController = CarControllerComponent.Cast(vehicle.FindComponent(CarControllerComponent));
+        if (carController)
+            carController.SetPersistentHandBrake(true);
+
+        m_aSpotStates[spot] = ETrafficParkedSpotState.SPAWNED;
+        m_mSpotVehicles.Insert(spot, vehicle);
+        m_iSpawnedTotal++;
+        return true;
+    }
+
+    // Deletes the spot's car if it is still parked there untouched; otherwise lets it go for good
+    protected void Despawn(int spot)
+    {
+        Vehicle vehicle = m_mSpotVehicles.Get(spot);
+        m_mSpotVehicles.Remove(spot);
+
+        ETrafficParkedSpotState state = GetLeaveState(spot, vehicle);
+        m_aSpotStates[spot] = state;
+
+        if (state == ETrafficParkedSpotState.FREE)
+        {
+            SCR_EntityHelper.DeleteEntityAndChildren(vehicle);
+            m_iDespawnedTotal++;
+        }
+        else if (state == ETrafficParkedSpotState.DESTROYED)
+        {
+            m_iDestroyedTotal++;
+        }
+        else
+        {
+            m_iTakenTotal++;
+        }
+    }
+
+    // What the spot becomes when its car is removed: FREE when the car can be deleted and spawned
+    // again later, TAKEN or DESTROYED when it must stay where it is
+    protected ETrafficParkedSpotState GetLeaveState(int spot, Vehicle vehicle)
+    {
+        if (!vehicle)
+            return ETrafficParkedSpotState.TAKEN;
+
+        DamageManagerComponent damage = DamageManagerComponent.Cast(vehicle.FindComponent(DamageManagerComponent));
+        if (damage && damage.GetState() == EDamageState.DESTROYED)
+            return ETrafficParkedSpotState.DESTROYED;
+
+        float takenSq = TAKEN_DISTANCE * TAKEN_DISTANCE;
+        if (vector.DistanceSqXZ(vehicle.GetOrigin(), m_aSpotPositions[spot]) > takenSq)
+            return ETrafficParkedSpotState.TAKEN;
+
+        BaseCompartmentManagerComponent compartments = BaseCompartmentManagerComponent.Cast(vehicle.FindComponent(BaseCompartmentManagerComponent));
+        if (compartments)
+        {
+            m_aOccupantBuffer.Clear();
+            compartments.GetOccupants(m_aOccupantBuffer);
+            if (!m_aOccupantBuffer.IsEmpty())
+                return ETrafficParkedSpotState.TAKEN;
+        }
+
+        return ETrafficParkedSpotState.FREE;
+    }
+}
@@ -0,0 +1,169 @@
+// ------------------------------------------------------------------------------------------------
+// Player positions captured once at the top of each traffic tick.
+// All later phases ask this snapshot instead of calling GetPlayerControlledEntity per query,
+// and proximity questions go through a coarse grid so cost stays flat with player count.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficPlayerSnapshot
+{
+    protected const float GRID_CELL_SIZE = 500.0;
+    protected const float DEFAULT_EYE_HEIGHT = 1.5;
+
+    protected ref array<int> m_aPlayerIds = {};
+    protected ref array<vector> m_aPositions = {};
+    protected ref array<vector> m_aEyePositions = {};
+    protected ref array<vector> m_aViewDirections = {};
+
+    protected ref SCR_TrafficSpatialGrid m_Grid = new SCR_TrafficSpatialGrid(GRID_CELL_SIZE);
+    protected ref array<int> m_aQueryBuffer = {};
+
+    // ------------------------------------------------------------------------------------------------
+    void Capture()
+    {
+        Clear();
+
+        PlayerManager playerMgr = GetGame().GetPlayerManager();
+        if (!playerMgr)
+            return;
+
+        array<int> playerIds = {};
+        playerMgr.GetPlayers(playerIds);
+
+        foreach (int playerId : playerIds)
+        {
+            IEntity player = playerMgr.GetPlayerControlledEntity(playerId);
+            if (!player)
+                continue;
+
+            vector pos = player.GetOrigin();
+
+            vector eyePos = pos;
+            ChimeraCharacter character = ChimeraCharacter.Cast(player);
+            if (character)
+                eyePos = character.EyePosition();
+            else
+                eyePos[1] = eyePos[1] + DEFAULT_EYE_HEIGHT;
+
+            vector angles = player.GetAngles();
+            AddObserver(playerId, pos, eyePos, angles.AnglesToVector());
+        }
+    }
+
+    void Clear()
+    {
+        m_aPlayerIds.Clear();
+        m_aPositions.Clear();
+        m_aEyePositions.Clear();
+        m_aViewDirections.Clear();
+        m_Grid.Clear();
+    }
+
+    // Benchmark observers stand in for players; ids are chosen by the caller
+    void AddSyntheticObserver(int observerId, vector pos, vector viewDir)
+    {
+        vector eyePos = pos;
+        eyePos[1] = eyePos[1] + DEFAULT_EYE_HEIGHT;
+        AddObserver(observerId, pos, eyePos, viewDir);
+    }
+
+    protected void AddObserver(int playerId, vector pos, vector eyePos, vector viewDir)
+    {
+        int index = m_aPositions.Count();
+        m_aPlayerIds.Insert(playerId);
+        m_aPositions.Insert(pos);
+        m_aEyePositions.Insert(eyePos);
+        m_aViewDirections.Insert(viewDir);
+        m_Grid.Insert(pos, index);
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    int GetCount()
+    {
+        return m_aPositions.Count();
+    }
+
+    bool IsEmpty()
+    {
+        return m_aPositions.IsEmpty();
+    }
+
+    int GetPlayerId(int index)
+    {
+        return m_aPlayerIds[index];
+    }
+
+    vector GetPosition(int index)
+    {
+        return m_aPositions[index];
+    }
+
+    vector GetEyePosition(int index)
+    {
+        return m_aEyePositions[index];
+    }
+
+    vector GetViewDirection(int index)
+    {
+        return m_aViewDirections[index];
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    bool IsAnyPlayerWithin(vector pos, float radius)
+    {
+        m_aQueryBuffer.Clear();
+        m_Grid.Query(pos, radius, m_aQueryBuffer);
+
+        float radiusSq = radius * radius;
+        foreach (int index : m_aQueryBuffer)
+        {
+            if (vector.DistanceSqXZ(pos, m_aPositions[index]) < radiusSq)
+                return true;
+        }
+
+        return false;
+    }
+
+    // Distance to the nearest player within maxRadius, or float.MAX when there is none.
+    float GetNearestPlayerDistance(vector pos, float maxRadius)
+    {
+        int index = GetNearestPlayerIndex(pos, maxRadius);
+        if (index == -1)
+            return float.MAX;
+
+        return vector.DistanceXZ(pos, m_aPositions[index]);
+    }
+
+    // Snapshot index of the nearest player within maxRadius, or -1
+    int GetNearestPlayerIndex(vector pos, float maxRadius)
+    {
+        m_aQueryBuffer.Clear();
+        m_Grid.Query(pos, maxRadius, m_aQueryBuffer);
+
+        float bestSq = maxRadius * maxRadius;
+        int best = -1;
+        foreach (int index : m_aQueryBuffer)
+        {
+            float distSq = vector.DistanceSqXZ(pos, m_aPositions[index]);
+            if (distSq <= bestSq)
+            {
+                bestSq = distSq;
+                best = index;
+            }
+        }
+
+        return best;
+    }
+
+    // Appends snapshot indices of players within radius of pos.
+    void GetPlayersWithin(vector pos, float radius, notnull array<int> outIndices)
+    {
+        m_aQueryBuffer.Clear();
+        m_Grid.Query(pos, radius, m_aQueryBuffer);
+
+        float radiusSq = radius * radius;
+        foreach (int index : m_aQueryBuffer)
+        {
+            if (vector.DistanceSqXZ(pos, m_aPositions[index]) < radiusSq)
+                outIndices.Insert(index);
+        }
+    }
+}
@@ -0,0 +1,42 @@
+// ------------------------------------------------------------------------------------------------
+// Single source of randomness for traffic decisions (spawn ring offsets, destinations, prefab
+// picks). Unseeded it defers to Math.Random*; the benchmark seeds it so runs repeat the same
+// sequence of choices.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficRandom
+{
+    protected static ref RandomGenerator s_Generator;
+
+    static void Seed(int seed)
+    {
+        s_Generator = new RandomGenerator();
+        s_Generator.SetSeed(seed);
+    }
+
+    static void Reset()
+    {
+        s_Generator = null;
+    }
+
+    static bool IsSeeded()
+    {
+        return s_Generator != null;
+    }
+
+    // [min, max)
+    static int RandomInt(int min, int max)
+    {
+        if (s_Generator)
+            return s_Generator.RandInt(min, max);
+
+        return Math.RandomInt(min, max);
+    }
+
+    static float RandomFloat(float min, float max)
+    {
+        if (s_Generator)
+            return s_Generator.RandFloatXY(min, max);
+
+        return Math.RandomFloat(min, max);
+    }
+}
@@ -0,0 +1,216 @@
+// ------------------------------------------------------------------------------------------------
+// Which clients receive which traffic cars. Every tick each car is checked against each player:
+// inside the relevance radius it is streamed to that player's client, once it is further than the
+// radius plus a hysteresis margin the client is told to stream it out. This works on top of the
+// server's network view distance and only ever narrows it. Streaming is switched on the vehicle's
+// RplComponent; the seated driver is a hierarchy child and goes with it.
+// The same pass counts the cars each client receives, which gives the per-client load used for the
+// bandwidth estimate. Counting also runs with the relevance radius off (against the engine's default
+// view distance) and for benchmark observers, so a mission can be measured before it is tuned.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficRelevance
+{
+    // Leaving relevance takes this much more distance than entering it, so a car on the edge does
+    // not flip every tick
+    protected const float HYSTERESIS = 100.0;
+    // Stand-in for the server's networkViewDistance when no relevance radius is set
+    protected const float ENGINE_VIEW_DISTANCE = 1500.0;
+
+    protected float m_fRadius;
+    protected float m_fBytesPerCar = 1000;
+    protected bool m_bControlStreaming;
+
+    // Per snapshot index, rebuilt each tick
+    protected ref array<int> m_aPlayerIds = {};
+    protected ref array<int> m_aCarsPerClient = {};
+    protected ref map<int, int> m_mPresent = new map<int, int>();
+    protected ref array<int> m_aPlayerBuffer = {};
+
+    // Streaming switches sent since the last ConsumeSwitches()
+    protected int m_iSwitches;
+
+    // ------------------------------------------------------------------------------------------------
+    // radius in metres (0 leaves streaming to the engine), bytesPerCar the estimated replication
+    // cost of one moving car with its driver, per second
+    void Configure(float radius, float bytesPerCar)
+    {
+        m_fRadius = Math.Max(0, radius);
+        m_fBytesPerCar = Math.Max(0, bytesPerCar);
+        m_bControlStreaming = m_fRadius > 0 && Replication.IsRunning();
+    }
+
+    bool IsControllingStreaming()
+    {
+        return m_bControlStreaming;
+    }
+
+    float GetBytesPerCar()
+    {
+        return m_fBytesPerCar;
+    }
+
+    // Streaming switches sent since the previous call
+    int ConsumeSwitches()
+    {
+        int switches = m_iSwitches;
+        m_iSwitches = 0;
+        return switches;
+    }
+
+    // Per-client car counts from the last tick, indexed like outPlayerIds
+    void GetClientLoad(notnull array<int> outPlayerIds, notnull array<int> outCars)
+    {
+        outPlayerIds.Copy(m_aPlayerIds);
+        outCars.Copy(m_aCarsPerClient);
+    }
+
+    // Cars streamed to the player's client in the last tick, or -1 when it was not in the snapshot
+    int GetCarsForPlayer(int playerId)
+    {
+        int index;
+        if (!m_mPresent.Find(playerId, index))
+            return -1;
+
+        return m_aCarsPerClient[index];
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    void Update(SCR_TrafficPlayerSnapshot snapshot, array<ref SCR_TrafficUnit> units)
+    {
+        m_aPlayerIds.Clear();
+        m_aCarsPerClient.Clear();
+        m_mPresent.Clear();
+
+        int players = snapshot.GetCount();
+        for (int i = 0; i < players; i++)
+        {
+            m_aPlayerIds.Insert(snapshot.GetPlayerId(i));
+            m_aCarsPerClient.Insert(0);
+            m_mPresent.Insert(snapshot.GetPlayerId(i), i);
+        }
+
+        float enter = m_fRadius;
+        if (enter <= 0)
+            enter = ENGINE_VIEW_DISTANCE;
+
+        float enterSq = enter * enter;
+        float leaveSq = (enter + HYSTERESIS) * (enter + HYSTERESIS);
+
+        foreach (SCR_TrafficUnit unit : units)
+        {
+            if (!unit.m_Vehicle)
+                continue;
+
+            vector pos = unit.m_Vehicle.GetOrigin();
+            for (int player = 0; player < players; player++)
+            {
+                int playerId = m_aPlayerIds[player];
+                bool streamed;
+                bool known = unit.m_mStreamedTo.Find(playerId, streamed);
+
+                float distSq = vector.DistanceSqXZ(pos, snapshot.GetPosition(player));
+                bool relevant = distSq < enterSq || (known && streamed && distSq < leaveSq);
+                if (relevant)
+                    m_aCarsPerClient[player] = m_aCarsPerClient[player] + 1;
+
+                if (!m_bControlStreaming || (known && streamed == relevant))
+                    continue;
+
+                if (SetStreamed(unit, playerId, relevant))
+                    unit.m_mStreamedTo.Set(playerId, relevant);
+            }
+
+            if (m_bControlStreaming)
+                PruneAbsent(unit);
+        }
+    }
+
+    // Streams a car that leaves the active set (parked in the pool) out of every client it was sent
+    // to; the next Update after it is unparked streams it back in where it is relevant
+    void Withdraw(SCR_TrafficUnit unit)
+    {
+        if (!m_bControlStreaming)
+            return;
+
+        m_aPlayerBuffer.Clear();
+        foreach (int playerId, bool streamed : unit.m_mStreamedTo)
+        {
+            if (streamed)
+                m_aPlayerBuffer.Insert(playerId);
+        }
+
+        foreach (int streamedTo : m_aPlayerBuffer)
+        {
+            if (SetStreamed(unit, streamedTo, false))
+                unit.m_mStreamedTo.Set(streamedTo, false);
+        }
+    }
+
+    // Average and peak cars per client, the peak client's estimated traffic bandwidth and the
+    // requesting player's own load, for the admin overlay
+    string FormatSummary(int playerId)
+    {
+        int clients = m_aCarsPerClient.Count();
+        int total = 0;
+        int peak = 0;
+        foreach (int cars : m_aCarsPerClient)
+        {
+            total += cars;
+            peak = Math.Max(peak, cars);
+        }
+
+        float average = 0;
+        if (clients > 0)
+        {
+            average = total;
+            average /= clients;
+        }
+
+        string mode = "engine";
+        if (m_bControlStreaming)
+            mode = string.Format("%1 m", m_fRadius);
+
+        string text = string.Format("Network (%1): %2 cars/client avg, %3 peak, ~%4 KB/s peak client",
+            mode, average.ToString(-1, 1), peak, SCR_TrafficStats.FormatKilobytes(peak, m_fBytesPerCar));
+
+        int own = GetCarsForPlayer(playerId);
+        if (own >= 0)
+            text += string.Format(" | you: %1 cars, ~%2 KB/s", own, SCR_TrafficStats.FormatKilobytes(own, m_fBytesPerCar));
+
+        return text;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // False when the player has no controller or connection yet; the switch is retried next tick
+    protected bool SetStreamed(SCR_TrafficUnit unit, int playerId, bool streamed)
+    {
+        if (!unit.m_VehicleRpl)
+            return false;
+
+        PlayerController controller = GetGame().GetPlayerManager().GetPlayerController(playerId);
+        if (!controller)
+            return false;
+
+        RplIdentity identity = controller.GetRplIdentity();
+        if (!identity.IsValid())
+            return false;
+
+        unit.m_VehicleRpl.EnableStreamingConNode(identity, streamed);
+        m_iSwitches++;
+        return true;
+    }
+
+    // Forgets players that left or have no body; their state is applied afresh when they are back
+    protected void PruneAbsent(SCR_TrafficUnit unit)
+    {
+        m_aPlayerBuffer.Clear();
+        foreach (int playerId, bool streamed : unit.m_mStreamedTo)
+        {
+            if (!m_mPresent.Contains(playerId))
+                m_aPlayerBuffer.Insert(playerId);
+        }
+
+        foreach (int absent : m_aPlayerBuffer)
+            unit.m_mStreamedTo.Remove(absent);
+    }
+}
@@ -0,0 +1,117 @@
+// ------------------------------------------------------------------------------------------------
+// Holds one strong Resource handle per prefab for the mission's lifetime, so spawns and flee
+// orders never hit a cold Resource.Load. Preloading runs one prefab per call-queue step after
+// Initialize, spreading the synchronous loads over several frames.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficResourceCache
+{
+    protected const int PRELOAD_INTERVAL_MS = 100;
+
+    protected ref map<ResourceName, ref Resource> m_mResources = new map<ResourceName, ref Resource>();
+    protected ref array<ResourceName> m_aPreloadQueue = {};
+
+    protected int m_iHits;
+    protected int m_iMisses;
+
+    // ------------------------------------------------------------------------------------------------
+    // Returns a valid resource or null. Invalid prefabs are remembered as null so they aren't retried.
+    Resource Get(ResourceName prefab)
+    {
+        if (prefab.IsEmpty())
+            return null;
+
+        Resource res;
+        if (m_mResources.Find(prefab, res))
+        {
+            m_iHits++;
+            return res;
+        }
+
+        m_iMisses++;
+        return LoadAndStore(prefab);
+    }
+
+    bool IsCached(ResourceName prefab)
+    {
+        return m_mResources.Contains(prefab);
+    }
+
+    protected Resource LoadAndStore(ResourceName prefab)
+    {
+        Resource res = Resource.Load(prefab);
+        if (!res || !res.IsValid())
+        {
+            Print(string.Format("[TRAFFIC] Prefab %1 could not be loaded.", prefab), LogLevel.WARNING);
+            res = null;
+        }
+
+        m_mResources.Set(prefab, res);
+        return res;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    void QueuePreload(ResourceName prefab)
+    {
+        if (prefab.IsEmpty() || m_mResources.Contains(prefab) || m_aPreloadQueue.Contains(prefab))
+            return;
+
+        m_aPreloadQueue.Insert(prefab);
+    }
+
+    void StartPreload()
+    {
+        if (m_aPreloadQueue.IsEmpty())
+            return;
+
+        GetGame().GetCallqueue().Remove(PreloadStep);
+        GetGame().GetCallqueue().CallLater(PreloadStep, PRELOAD_INTERVAL_MS, true);
+    }
+
+    protected void PreloadStep()
+    {
+        while (!m_aPreloadQueue.IsEmpty())
+        {
+            ResourceName prefab = m_aPreloadQueue[0];
+            m_aPreloadQueue.RemoveOrdered(0);
+
+            // Another caller may have loaded it in the meantime; only spend the step on a real load
+            if (m_mResources.Contains(prefab))
+                continue;
+
+            LoadAndStore(prefab);
+            break;
+        }
+
+        if (m_aPreloadQueue.IsEmpty())
+        {
+            GetGame().GetCallqueue().Remove(PreloadStep);
+            Print(string.Format("[TRAFFIC] Prefab preload finished: %1 resources cached.", m_mResources.Count()), LogLevel.NORMAL);
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    int GetHits()
+    {
+        return m_iHits;
+    }
+
+    int GetMisses()
+    {
+        return m_iMisses;
+    }
+
+    int GetCachedCount()
+    {
+        return m_mResources.Count();
+    }
+
+    void Clear()
+    {
+        ScriptCallQueue queue = GetGame().GetCallqueue();
+        if (queue)
+            queue.Remove(PreloadStep);
+
+        m_aPreloadQueue.Clear();
+        m_mResources.Clear();
+    }
+}
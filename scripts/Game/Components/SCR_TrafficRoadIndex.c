@@ -0,0 +1,732 @@
+// ------------------------------------------------------------------------------------------------
+// Road spawn-point index — built once at Initialize by sampling every road polyline.
+// Spawn queries then only touch grid cells around players instead of the whole map.
+// Roads are also grouped into connected components (joined where an endpoint meets another road)
+// so spawn/destination pairs can be drawn from the same component without pathfinding trials.
+// The finished analysis is cached in the profile directory, keyed by world, loaded addons and a
+// fingerprint of the road network; later boots of the same map read it back line by line.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficRoadIndex
+{
+    protected const float SAMPLE_SPACING = 40.0;
+    protected const float GATHER_TILE_SIZE = 1000.0;
+    protected const float GRID_CELL_SIZE = 250.0;
+    protected const float JOIN_TOLERANCE = 8.0;
+    protected const int MIN_COMPONENT_POINTS = 10;
+    protected const int MAX_DESTINATION_POOL = 512;
+
+    protected const int CACHE_VERSION = 2;
+    protected const string CACHE_DIRECTORY = "$profile:GRAD_Traffic";
+
+    // Structure-of-arrays, indexed by point id
+    protected ref array<vector> m_aPositions = {};
+    protected ref array<vector> m_aDirections = {};
+    protected ref array<int> m_aRoadIds = {};
+
+    // Per road: polyline endpoints and connected component label
+    protected ref array<vector> m_aRoadStarts = {};
+    protected ref array<vector> m_aRoadEnds = {};
+    protected ref array<int> m_aRoadComponents = {};
+
+    // Per component: evenly thinned point ids usable as destinations (empty for tiny components)
+    protected ref array<ref array<int>> m_aDestinationPools = {};
+
+    protected ref SCR_TrafficSpatialGrid m_Grid = new SCR_TrafficSpatialGrid(GRID_CELL_SIZE);
+    protected int m_iRoadCount;
+    protected bool m_bBuilt;
+
+    // ------------------------------------------------------------------------------------------------
+    bool IsBuilt()
+    {
+        return m_bBuilt;
+    }
+
+    int GetPointCount()
+    {
+        return m_aPositions.Count();
+    }
+
+    int GetRoadCount()
+    {
+        return m_iRoadCount;
+    }
+
+    vector GetPosition(int pointId)
+    {
+        return m_aPositions[pointId];
+    }
+
+    vector GetDirection(int pointId)
+    {
+        return m_aDirections[pointId];
+    }
+
+    int GetRoadId(int pointId)
+    {
+        return m_aRoadIds[pointId];
+    }
+
+    int GetComponent(int pointId)
+    {
+        return m_aRoadComponents[m_aRoadIds[pointId]];
+    }
+
+    int GetComponentCount()
+    {
+        return m_aDestinationPools.Count();
+    }
+
+    // Spawns are only placed on components large enough to offer a destination
+    bool IsSpawnable(int pointId)
+    {
+        return !m_aDestinationPools[GetComponent(pointId)].IsEmpty();
+    }
+
+    // Random destination on the same component as fromPointId, preferring ones at least minDistance away.
+    // Returns -1 only when the component has no destination pool.
+    int PickDestination(int fromPointId, float minDistance, int attempts)
+    {
+        array<int> pool = m_aDestinationPools[GetComponent(fromPointId)];
+        if (pool.IsEmpty())
+            return -1;
+
+        vector from = m_aPositions[fromPointId];
+        float minSq = minDistance * minDistance;
+        int best = -1;
+        float bestSq = -1;
+
+        for (int i = 0; i < attempts; i++)
+        {
+            int candidate = pool[SCR_TrafficRandom.RandomInt(0, pool.Count())];
+            float distSq = vector.DistanceSqXZ(from, m_aPositions[candidate]);
+            if (distSq >= minSq)
+                return candidate;
+
+            if (distSq > bestSq)
+            {
+                bestSq = distSq;
+                best = candidate;
+            }
+        }
+
+        // Small component: settle for the farthest candidate seen
+        return best;
+    }
+
+    // Destination on fromPointId's component within maxRadius of center and at least minDistance
+    // from the start, for legs that should stay near players. Samples the destination pool first
+    // and falls back to scanning the indexed points around center. Returns -1 if there is none.
+    int PickDestinationWithin(int fromPointId, vector center, float maxRadius, float minDistance, int attempts)
+    {
+        int component = GetComponent(fromPointId);
+        vector from = m_aPositions[fromPointId];
+        float maxSq = maxRadius * maxRadius;
+        float minSq = minDistance * minDistance;
+
+        array<int> pool = m_aDestinationPools[component];
+        if (!pool.IsEmpty())
+        {
+            for (int i = 0; i < attempts; i++)
+            {
+                int candidate = pool[SCR_TrafficRandom.RandomInt(0, pool.Count())];
+                if (vector.DistanceSqXZ(center, m_aPositions[candidate]) <= maxSq && vector.DistanceSqXZ(from, m_aPositions[candidate]) >= minSq)
+                    return candidate;
+            }
+        }
+
+        array<int> nearby = {};
+        QueryRing(center, 0, maxRadius, nearby);
+
+        int count = nearby.Count();
+        if (count == 0)
+            return -1;
+
+        int offset = SCR_TrafficRandom.RandomInt(0, count);
+        for (int i = 0; i < count; i++)
+        {
+            int candidate = nearby[(offset + i) % count];
+            if (GetComponent(candidate) == component && vector.DistanceSqXZ(from, m_aPositions[candidate]) >= minSq)
+                return candidate;
+        }
+
+        return -1;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Gathers every road, then either loads the matching cache file or analyses the roads
+    // and writes a fresh cache (when useCache is set).
+    bool Build(RoadNetworkManager roadMgr, bool useCache = true)
+    {
+        Clear();
+
+        if (!roadMgr)
+            return false;
+
+        int startTime = System.GetTickCount();
+
+        array<BaseRoad> roads = {};
+        GatherRoads(roadMgr, roads);
+
+        string cacheKey = ComputeCacheKey(roads);
+        string cachePath = string.Format("%1/roadindex_%2.txt", CACHE_DIRECTORY, cacheKey.Hash());
+
+        if (useCache && LoadFromFile(cachePath, cacheKey))
+        {
+            Print(string.Format("[TRAFFIC] Road index loaded from cache %1: %2 spawn points, %3 components in %4 ms",
+                cachePath, m_aPositions.Count(), m_aDestinationPools.Count(), System.GetTickCount() - startTime), LogLevel.NORMAL);
+            return m_bBuilt;
+        }
+
+        Clear();
+        Analyse(roads);
+
+        Print(string.Format("[TRAFFIC] Road index built: %1 roads, %2 spawn points, %3 components in %4 ms",
+            m_iRoadCount, m_aPositions.Count(), m_aDestinationPools.Count(), System.GetTickCount() - startTime), LogLevel.NORMAL);
+
+        if (useCache && m_bBuilt)
+            SaveToFile(cachePath, cacheKey);
+
+        return m_bBuilt;
+    }
+
+    // Collects every road once, tile by tile (one full-map GetRoadsInAABB returns duplicates for
+    // long roads anyway).
+    protected void GatherRoads(RoadNetworkManager roadMgr, notnull array<BaseRoad> outRoads)
+    {
+        vector mapMin, mapMax;
+        GetGame().GetWorldEntity().GetWorldBounds(mapMin, mapMax);
+
+        set<BaseRoad> seen = new set<BaseRoad>();
+        array<BaseRoad> tileRoads = {};
+
+        for (float x = mapMin[0]; x < mapMax[0]; x += GATHER_TILE_SIZE)
+        {
+            for (float z = mapMin[2]; z < mapMax[2]; z += GATHER_TILE_SIZE)
+            {
+                tileRoads.Clear();
+                roadMgr.GetRoadsInAABB(Vector(x, mapMin[1], z), Vector(x + GATHER_TILE_SIZE, mapMax[1], z + GATHER_TILE_SIZE), tileRoads);
+
+                foreach (BaseRoad road : tileRoads)
+                {
+                    if (!road || seen.Contains(road))
+                        continue;
+
+                    seen.Insert(road);
+                    outRoads.Insert(road);
+                }
+            }
+        }
+    }
+
+    // Samples every polyline at SAMPLE_SPACING, then labels components and builds destination pools
+    protected void Analyse(array<BaseRoad> roads)
+    {
+        array<vector> points = {};
+        foreach (BaseRoad road : roads)
+        {
+            points.Clear();
+            road.GetPoints(points);
+            if (points.Count() < 2)
+                continue;
+
+            m_aRoadStarts.Insert(points[0]);
+            m_aRoadEnds.Insert(points[points.Count() - 1]);
+            SampleRoad(m_iRoadCount, points);
+            m_iRoadCount++;
+        }
+
+        LabelComponents();
+        BuildDestinationPools();
+
+        m_bBuilt = !m_aPositions.IsEmpty();
+    }
+
+    void Clear()
+    {
+        m_aPositions.Clear();
+        m_aDirections.Clear();
+        m_aRoadIds.Clear();
+        m_aRoadStarts.Clear();
+        m_aRoadEnds.Clear();
+        m_aRoadComponents.Clear();
+        m_aDestinationPools.Clear();
+        m_Grid.Clear();
+        m_iRoadCount = 0;
+        m_bBuilt = false;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected void SampleRoad(int roadId, array<vector> points)
+    {
+        int count = points.Count();
+        if (count < 2)
+            return;
+
+        // Carry leftover distance across segments so spacing stays even along the whole polyline
+        float carry = 0;
+        vector lastDir;
+        bool hasDir = false;
+        for (int i = 0; i < count - 1; i++)
+        {
+            vector a = points[i];
+            vector b = points[i + 1];
+            float segLen = vector.Distance(a, b);
+            if (segLen < 0.01)
+                continue;
+
+            vector dir = (b - a) * (1.0 / segLen);
+            float t = carry;
+            while (t < segLen)
+            {
+                AddPoint(a + dir * t, dir, roadId);
+                t += SAMPLE_SPACING;
+            }
+
+            carry = t - segLen;
+            lastDir = dir;
+            hasDir = true;
+        }
+
+        // The end vertex always gets a sample, so roads meeting end to end lie within one spacing of
+        // each other's samples and LabelComponents joins them. Skipped when the last regular sample
+        // already sits on it.
+        if (hasDir && SAMPLE_SPACING - carry > 0.01)
+            AddPoint(points[count - 1], lastDir, roadId);
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Union-find over roads: two roads are joined when an endpoint of one lies within JOIN_TOLERANCE
+    // of the other's polyline (end-to-end joints and T-junctions alike). Gaps and water crossings
+    // without a road therefore end up as separate components.
+    protected void LabelComponents()
+    {
+        array<int> parent = {};
+        parent.Resize(m_iRoadCount);
+        for (int r = 0; r < m_iRoadCount; r++)
+            parent[r] = r;
+
+        array<int> nearby = {};
+        for (int r = 0; r < m_iRoadCount; r++)
+        {
+            for (int e = 0; e < 2; e++)
+            {
+                vector endpoint = m_aRoadStarts[r];
+                if (e == 1)
+                    endpoint = m_aRoadEnds[r];
+
+                nearby.Clear();
+                m_Grid.Query(endpoint, SAMPLE_SPACING + JOIN_TOLERANCE, nearby);
+
+                foreach (int id : nearby)
+                {
+                    int other = m_aRoadIds[id];
+                    if (other == r || FindRoot(parent, other) == FindRoot(parent, r))
+                        continue;
+
+                    if (IsNearRoadSample(endpoint, id))
+                        parent[FindRoot(parent, other)] = FindRoot(parent, r);
+                }
+            }
+        }
+
+        // Compact roots into 0..n-1 labels
+        map<int, int> labels = new map<int, int>();
+        m_aRoadComponents.Resize(m_iRoadCount);
+        for (int r = 0; r < m_iRoadCount; r++)
+        {
+            int root = FindRoot(parent, r);
+            int label;
+            if (!labels.Find(root, label))
+            {
+                label = labels.Count();
+                labels.Insert(root, label);
+            }
+
+            m_aRoadComponents[r] = label;
+        }
+
+        for (int c = 0; c < labels.Count(); c++)
+            m_aDestinationPools.Insert(new array<int>());
+    }
+
+    protected int FindRoot(array<int> parent, int node)
+    {
+        while (parent[node] != node)
+        {
+            parent[node] = parent[parent[node]];
+            node = parent[node];
+        }
+
+        return node;
+    }
+
+    // True when pos is within JOIN_TOLERANCE of the sample or of the segment to the next sample on the same road
+    protected bool IsNearRoadSample(vector pos, int id)
+    {
+        float tolSq = JOIN_TOLERANCE * JOIN_TOLERANCE;
+        vector a = m_aPositions[id];
+        if (vector.DistanceSqXZ(pos, a) <= tolSq)
+            return true;
+
+        int next = id + 1;
+        if (next >= m_aPositions.Count() || m_aRoadIds[next] != m_aRoadIds[id])
+            return false;
+
+        vector b = m_aPositions[next];
+        vector ab = b - a;
+        ab[1] = 0;
+        float lenSq = ab.LengthSq();
+        if (lenSq < 0.0001)
+            return false;
+
+        vector ap = pos - a;
+        ap[1] = 0;
+        float t = Math.Clamp(vector.Dot(ap, ab) / lenSq, 0, 1);
+        return vector.DistanceSqXZ(pos, a + ab * t) <= tolSq;
+    }
+
+    protected void BuildDestinationPools()
+    {
+        array<int> sizes = {};
+        sizes.Resize(m_aDestinationPools.Count());
+
+        int pointCount = m_aPositions.Count();
+        for (int i = 0; i < pointCount; i++)
+            sizes[GetComponent(i)] = sizes[GetComponent(i)] + 1;
+
+        array<int> seen = {};
+        seen.Resize(sizes.Count());
+
+        for (int i = 0; i < pointCount; i++)
+        {
+            int component = GetComponent(i);
+            int size = sizes[component];
+            if (size < MIN_COMPONENT_POINTS)
+                continue;
+
+            // Thin large components evenly so the pool stays bounded
+            int stride = (size + MAX_DESTINATION_POOL - 1) / MAX_DESTINATION_POOL;
+            if (seen[component] % stride == 0)
+                m_aDestinationPools[component].Insert(i);
+
+            seen[component] = seen[component] + 1;
+        }
+    }
+
+    protected void AddPoint(vector pos, vector dir, int roadId)
+    {
+        int id = m_aPositions.Count();
+        m_aPositions.Insert(pos);
+        m_aDirections.Insert(dir);
+        m_aRoadIds.Insert(roadId);
+        m_Grid.Insert(pos, id);
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Cache
+    // ------------------------------------------------------------------------------------------------
+    // Identifies the analysis input: format version, world file, loaded addons and a fingerprint of
+    // road count and quantized endpoints. Any change to the map or mod set yields a different key.
+    protected string ComputeCacheKey(array<BaseRoad> roads)
+    {
+        int fingerprint = roads.Count();
+        array<vector> points = {};
+        foreach (BaseRoad road : roads)
+        {
+            points.Clear();
+            road.GetPoints(points);
+            if (points.IsEmpty())
+                continue;
+
+            vector first = points[0];
+            vector last = points[points.Count() - 1];
+            int firstX = Math.Round(first[0]);
+            int firstZ = Math.Round(first[2]);
+            int lastX = Math.Round(last[0]);
+            int lastZ = Math.Round(last[2]);
+            fingerprint = fingerprint * 31 + firstX * 7 + firstZ;
+            fingerprint = fingerprint * 31 + lastX * 7 + lastZ;
+            fingerprint = fingerprint * 31 + points.Count();
+        }
+
+        array<string> addons = {};
+        GameProject.GetLoadedAddons(addons);
+        string addonList;
+        foreach (string addonGuid : addons)
+            addonList += addonGuid + ";";
+
+        return string.Format("v%1|%2|%3|%4", CACHE_VERSION, GetGame().GetWorldFile(), addonList.Hash(), fingerprint);
+    }
+
+    // Layout: key line, counts line "roads points components", one "x y z dx dy dz road" line per
+    // point, one line of road component labels, then one line of point ids per destination pool.
+    protected bool SaveToFile(string path, string cacheKey)
+    {
+        FileIO.MakeDirectory(CACHE_DIRECTORY);
+
+        FileHandle file = FileIO.OpenFile(path, FileMode.WRITE);
+        if (!file)
+        {
+            Print(string.Format("[TRAFFIC] Could not write road index cache %1", path), LogLevel.WARNING);
+            return false;
+        }
+
+        file.WriteLine(cacheKey);
+        file.WriteLine(string.Format("%1 %2 %3", m_iRoadCount, m_aPositions.Count(), m_aDestinationPools.Count()));
+
+        int pointCount = m_aPositions.Count();
+        for (int i = 0; i < pointCount; i++)
+        {
+            vector pos = m_aPositions[i];
+            vector dir = m_aDirections[i];
+            file.WriteLine(string.Format("%1 %2 %3 %4 %5 %6 %7", pos[0], pos[1], pos[2], dir[0], dir[1], dir[2], m_aRoadIds[i]));
+        }
+
+        file.WriteLine(JoinInts(m_aRoadComponents));
+        foreach (array<int> pool : m_aDestinationPools)
+            file.WriteLine(JoinInts(pool));
+
+        file.Close();
+        return true;
+    }
+
+    protected bool LoadFromFile(string path, string expectedKey)
+    {
+        if (!FileIO.FileExists(path))
+            return false;
+
+        FileHandle file = FileIO.OpenFile(path, FileMode.READ);
+        if (!file)
+            return false;
+
+        bool ok = ReadCache(file, expectedKey);
+        file.Close();
+
+        if (!ok)
+        {
+            Print(string.Format("[TRAFFIC] Road index cache %1 is stale or corrupt, rebuilding.", path), LogLevel.NORMAL);
+            Clear();
+        }
+
+        return ok;
+    }
+
+    // Every id read back is range-checked against the counts line, so a truncated or hand-edited
+    // file fails here instead of indexing out of bounds at runtime
+    protected bool ReadCache(FileHandle file, string expectedKey)
+    {
+        string line;
+        if (file.ReadLine(line) < 0 || line != expectedKey)
+            return false;
+
+        array<string> tokens = {};
+        if (file.ReadLine(line) < 0)
+            return false;
+
+        line.Split(" ", tokens, true);
+        if (tokens.Count() != 3)
+            return false;
+
+        int pointCount;
+        int componentCount;
+        if (!ParseInt(tokens[0], m_iRoadCount) || !ParseInt(tokens[1], pointCount) || !ParseInt(tokens[2], componentCount))
+            return false;
+
+        if (m_iRoadCount < 0 || pointCount < 0 || componentCount < 0)
+            return false;
+
+        for (int i = 0; i < pointCount; i++)
+        {
+            if (file.ReadLine(line) < 0)
+                return false;
+
+            tokens.Clear();
+            line.Split(" ", tokens, true);
+            if (tokens.Count() != 7)
+                return false;
+
+            int roadId;
+            if (!ParseInt(tokens[6], roadId) || roadId < 0 || roadId >= m_iRoadCount)
+                return false;
+
+            vector pos = Vector(tokens[0].ToFloat(), tokens[1].ToFloat(), tokens[2].ToFloat());
+            vector dir = Vector(tokens[3].ToFloat(), tokens[4].ToFloat(), tokens[5].ToFloat());
+            AddPoint(pos, dir, roadId);
+        }
+
+        if (file.ReadLine(line) < 0 || !SplitInts(line, m_aRoadComponents) || m_aRoadComponents.Count() != m_iRoadCount)
+            return false;
+
+        if (!AreInRange(m_aRoadComponents, componentCount))
+            return false;
+
+        for (int c = 0; c < componentCount; c++)
+        {
+            array<int> pool = {};
+            if (file.ReadLine(line) < 0 || !SplitInts(line, pool) || !AreInRange(pool, pointCount))
+                return false;
+
+            m_aDestinationPools.Insert(pool);
+        }
+
+        m_bBuilt = !m_aPositions.IsEmpty();
+        return true;
+    }
+
+    protected static string JoinInts(array<int> values)
+    {
+        string result;
+        foreach (int i, int value : values)
+        {
+            if (i > 0)
+                result += " ";
+
+            result += value.ToString();
+        }
+
+        return result;
+    }
+
+    // False on the first token that is not an integer as JoinInts writes it
+    protected static bool SplitInts(string line, notnull array<int> outValues)
+    {
+        array<string> tokens = {};
+        line.Split(" ", tokens, true);
+        foreach (string token : tokens)
+        {
+            int value;
+            if (!ParseInt(token, value))
+                return false;
+
+            outValues.Insert(value);
+        }
+
+        return true;
+    }
+
+    // ToInt() yields 0 for garbage, so the value must print back to the exact token
+    protected static bool ParseInt(string token, out int value)
+    {
+        value = token.ToInt();
+        return value.ToString() == token;
+    }
+
+    // Every value is a valid index into something of the given size
+    protected static bool AreInRange(array<int> values, int size)
+    {
+        foreach (int value : values)
+        {
+            if (value < 0 || value >= size)
+                return false;
+        }
+
+        return true;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Appends the ids of all points whose XZ distance to center lies in [minRadius, maxRadius].
+    void QueryRing(vector center, float minRadius, float maxRadius, notnull array<int> outIds)
+    {
+        array<int> broad = {};
+        m_Grid.Query(center, maxRadius, broad);
+
+        float minSq = minRadius * minRadius;
+        float maxSq = maxRadius * maxRadius;
+
+        foreach (int id : broad)
+        {
+            float distSq = vector.DistanceSqXZ(center, m_aPositions[id]);
+            if (distSq >= minSq && distSq <= maxSq)
+                outIds.Insert(id);
+        }
+    }
+
+    // Spawnable points within radius of center, as a measure of how much drivable road is around it
+    int CountSpawnablePoints(vector center, float radius)
+    {
+        array<int> nearby = {};
+        QueryRing(center, 0, radius, nearby);
+
+        int count;
+        foreach (int id : nearby)
+        {
+            if (IsSpawnable(id))
+                count++;
+        }
+
+        return count;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Navigation helpers for entity-less traffic. Points of one road are stored consecutively, so
+    // stepping +1/-1 walks the road; -1 is returned at its ends.
+    static float GetSampleSpacing()
+    {
+        return SAMPLE_SPACING;
+    }
+
+    int GetNextPointOnRoad(int pointId, int step)
+    {
+        int next = pointId + step;
+        if (next < 0 || next >= m_aPositions.Count() || m_aRoadIds[next] != m_aRoadIds[pointId])
+            return -1;
+
+        return next;
+    }
+
+    // Points on other roads close enough to pointId to count as a junction with it
+    void GetConnectedPoints(int pointId, notnull array<int> outIds)
+    {
+        vector pos = m_aPositions[pointId];
+        int roadId = m_aRoadIds[pointId];
+        float radius = SAMPLE_SPACING * 0.5 + JOIN_TOLERANCE;
+
+        array<int> broad = {};
+        m_Grid.Query(pos, radius, broad);
+
+        float radiusSq = radius * radius;
+        foreach (int id : broad)
+        {
+            if (m_aRoadIds[id] != roadId && vector.DistanceSqXZ(pos, m_aPositions[id]) <= radiusSq)
+                outIds.Insert(id);
+        }
+    }
+
+    // Uniformly random point on a component that can host traffic, or -1
+    int GetRandomSpawnablePoint(int attempts)
+    {
+        int count = m_aPositions.Count();
+        if (count == 0)
+            return -1;
+
+        for (int i = 0; i < attempts; i++)
+        {
+            int pointId = SCR_TrafficRandom.RandomInt(0, count);
+            if (IsSpawnable(pointId))
+                return pointId;
+        }
+
+        return -1;
+    }
+
+    // Nearest indexed point within maxRadius, or -1.
+    int FindNearestPoint(vector pos, float maxRadius)
+    {
+        array<int> broad = {};
+        m_Grid.Query(pos, maxRadius, broad);
+
+        int best = -1;
+        float bestSq = maxRadius * maxRadius;
+        foreach (int id : broad)
+        {
+            float distSq = vector.DistanceSqXZ(pos, m_aPositions[id]);
+            if (distSq < bestSq)
+            {
+                bestSq = distSq;
+                best = id;
+            }
+        }
+
+        return best;
+    }
+}
@@ -0,0 +1,126 @@
+// ------------------------------------------------------------------------------------------------
+// Uniform XZ grid mapping world positions to integer ids (point indices, player slots, unit ids).
+// Owners keep the actual data; the grid only answers "which ids are near here".
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficSpatialGrid
+{
+    protected const int CELL_KEY_STRIDE = 100000;
+
+    protected float m_fCellSize;
+    protected ref map<int, ref array<int>> m_mCells = new map<int, ref array<int>>();
+
+    void SCR_TrafficSpatialGrid(float cellSize)
+    {
+        m_fCellSize = Math.Max(1.0, cellSize);
+    }
+
+    float GetCellSize()
+    {
+        return m_fCellSize;
+    }
+
+    int GetCellX(vector pos)
+    {
+        return Math.Floor(pos[0] / m_fCellSize);
+    }
+
+    int GetCellZ(vector pos)
+    {
+        return Math.Floor(pos[2] / m_fCellSize);
+    }
+
+    static int MakeKey(int cx, int cz)
+    {
+        return cx * CELL_KEY_STRIDE + cz;
+    }
+
+    int GetKey(vector pos)
+    {
+        return MakeKey(GetCellX(pos), GetCellZ(pos));
+    }
+
+    void Clear()
+    {
+        m_mCells.Clear();
+    }
+
+    bool IsEmpty()
+    {
+        return m_mCells.IsEmpty();
+    }
+
+    void Insert(vector pos, int id)
+    {
+        int key = GetKey(pos);
+        array<int> cell = m_mCells.Get(key);
+        if (!cell)
+        {
+            cell = {};
+            m_mCells.Insert(key, cell);
+        }
+
+        cell.Insert(id);
+    }
+
+    void Remove(vector pos, int id)
+    {
+        RemoveFromCell(GetKey(pos), id);
+    }
+
+    // Moves an id between cells; returns the new cell key so callers can cache it.
+    int Move(int oldKey, vector newPos, int id)
+    {
+        int newKey = GetKey(newPos);
+        if (newKey == oldKey)
+            return newKey;
+
+        RemoveFromCell(oldKey, id);
+
+        array<int> cell = m_mCells.Get(newKey);
+        if (!cell)
+        {
+            cell = {};
+            m_mCells.Insert(newKey, cell);
+        }
+
+        cell.Insert(id);
+        return newKey;
+    }
+
+    void RemoveFromCell(int key, int id)
+    {
+        array<int> cell = m_mCells.Get(key);
+        if (!cell)
+            return;
+
+        cell.RemoveItem(id);
+        if (cell.IsEmpty())
+            m_mCells.Remove(key);
+    }
+
+    // Ids stored in one cell, or null when it is empty. Owned by the grid; do not modify.
+    array<int> GetCell(int key)
+    {
+        return m_mCells.Get(key);
+    }
+
+    // Appends every id stored in cells overlapping the square [center - radius, center + radius].
+    // Callers still need an exact distance test; this is the broad phase only.
+    void Query(vector center, float radius, notnull array<int> outIds)
+    {
+        int minX = Math.Floor((center[0] - radius) / m_fCellSize);
+        int maxX = Math.Floor((center[0] + radius) / m_fCellSize);
+        int minZ = Math.Floor((center[2] - radius) / m_fCellSize);
+        int maxZ = Math.Floor((center[2] + radius) / m_fCellSize);
+
+        for (int cx = minX; cx <= maxX; cx++)
+        {
+            for (int cz = minZ; cz <= maxZ; cz++)
+            {
+                array<int> cell = m_mCells.Get(MakeKey(cx, cz));
+                if (cell)
+                    outIds.InsertAll(cell);
+            }
+        }
+    }
+}
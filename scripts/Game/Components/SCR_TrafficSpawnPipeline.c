@@ -0,0 +1,389 @@
+enum ETrafficSpawnStage
+{
+    SPAWN_GROUP,
+    SPAWN_VEHICLE,
+    SPAWN_DRIVER,
+    LINK_AGENT,
+    SEAT_DRIVER,
+    WAIT_SEATED,
+    WAIT_GROUP,
+    DONE,
+    FAILED
+}
+
+// ------------------------------------------------------------------------------------------------
+// One unit being built by the pipeline
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficSpawnJob
+{
+    ref SCR_TrafficUnit m_Unit = new SCR_TrafficUnit();
+    ref EntitySpawnParams m_Params;
+    ResourceName m_VehiclePrefab;
+    ETrafficSpawnStage m_eStage = ETrafficSpawnStage.SPAWN_GROUP;
+    float m_fStageStartTime;
+
+    // Warm-up jobs go straight into the vehicle pool instead of onto the road
+    bool m_bParkWhenReady;
+
+    vector GetPosition()
+    {
+        return m_Params.Transform[3];
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds traffic units as a state machine instead of in one frame. Every frame each in-flight job
+// advances by at most one stage, within an entity-spawn and time budget. Waiting stages move on as
+// soon as their condition holds (agent exists, driver seated, group populated), not after fixed
+// delays, and give up after STAGE_TIMEOUT.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficSpawnPipeline
+{
+    protected const int MAX_ENTITY_SPAWNS_PER_FRAME = 1;
+    protected const int FRAME_BUDGET_MS = 2;
+    protected const float STAGE_TIMEOUT = 10.0;
+
+    protected SCR_AmbientTrafficManager m_Manager;
+    protected SCR_TrafficResourceCache m_ResourceCache;
+    protected ResourceName m_GroupPrefab;
+    protected ResourceName m_DriverPrefab;
+    // AI groups are spawned without replication; only the server needs them
+    protected bool m_bLocalGroups;
+
+    protected ref array<ref SCR_TrafficSpawnJob> m_aJobs = {};
+    protected int m_iNextJob;
+    protected bool m_bTicking;
+
+    // ------------------------------------------------------------------------------------------------
+    void SCR_TrafficSpawnPipeline(SCR_AmbientTrafficManager manager, SCR_TrafficResourceCache resourceCache, ResourceName groupPrefab, ResourceName driverPrefab)
+    {
+        m_Manager = manager;
+        m_ResourceCache = resourceCache;
+        m_GroupPrefab = groupPrefab;
+        m_DriverPrefab = driverPrefab;
+    }
+
+    void ~SCR_TrafficSpawnPipeline()
+    {
+        Clear();
+    }
+
+    void SetLocalGroups(bool localGroups)
+    {
+        m_bLocalGroups = localGroups;
+    }
+
+    int GetInFlightCount()
+    {
+        return m_aJobs.Count();
+    }
+
+    // True when an in-flight job will appear within radius of pos
+    bool IsJobNear(vector pos, float radius)
+    {
+        float radiusSq = radius * radius;
+        foreach (SCR_TrafficSpawnJob job : m_aJobs)
+        {
+            if (!job.m_bParkWhenReady && vector.DistanceSqXZ(pos, job.GetPosition()) < radiusSq)
+                return true;
+        }
+
+        return false;
+    }
+
+    // Where in-flight jobs will put their cars; warm-up jobs headed for the pool are skipped
+    void GetJobPositions(notnull array<vector> outPositions)
+    {
+        foreach (SCR_TrafficSpawnJob job : m_aJobs)
+        {
+            if (!job.m_bParkWhenReady)
+                outPositions.Insert(job.GetPosition());
+        }
+    }
+
+    void Enqueue(SCR_TrafficSpawnJob job)
+    {
+        job.m_fStageStartTime = GetTime();
+        m_aJobs.Insert(job);
+
+        if (!m_bTicking)
+        {
+            m_bTicking = true;
+            GetGame().GetCallqueue().CallLater(Tick, 0, true);
+        }
+    }
+
+    // Aborts all in-flight jobs and deletes what they already spawned
+    void Clear()
+    {
+        ScriptCallQueue queue = GetGame().GetCallqueue();
+        if (queue)
+            queue.Remove(Tick);
+
+        m_bTicking = false;
+
+        foreach (SCR_TrafficSpawnJob job : m_aJobs)
+            job.m_Unit.Delete();
+
+        m_aJobs.Clear();
+        m_iNextJob = 0;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected void Tick()
+    {
+        SCR_TrafficStats stats = m_Manager.GetStats();
+        stats.BeginPhase(ETrafficPhase.SPAWN_STAGES);
+
+        int startTick = System.GetTickCount();
+        int entitySpawns;
+        int jobCount = m_aJobs.Count();
+
+        // Round-robin so a job stuck waiting can't starve the ones behind it
+        for (int i = 0; i < jobCount; i++)
+        {
+            if (System.GetTickCount() - startTick >= FRAME_BUDGET_MS)
+                break;
+
+            if (m_iNextJob >= m_aJobs.Count())
+                m_iNextJob = 0;
+
+            SCR_TrafficSpawnJob job = m_aJobs[m_iNextJob];
+            m_iNextJob++;
+
+            // Entity spawns are the expensive stages; waiting stages are cheap checks and always run
+            if (IsSpawnStage(job.m_eStage))
+            {
+                if (entitySpawns >= MAX_ENTITY_SPAWNS_PER_FRAME)
+                    continue;
+
+                entitySpawns++;
+            }
+
+            Advance(job);
+        }
+
+        FinishJobs();
+        stats.EndPhase(ETrafficPhase.SPAWN_STAGES);
+
+        if (m_aJobs.IsEmpty())
+        {
+            GetGame().GetCallqueue().Remove(Tick);
+            m_bTicking = false;
+        }
+    }
+
+    protected bool IsSpawnStage(ETrafficSpawnStage stage)
+    {
+        return stage == ETrafficSpawnStage.SPAWN_GROUP || stage == ETrafficSpawnStage.SPAWN_VEHICLE || stage == ETrafficSpawnStage.SPAWN_DRIVER;
+    }
+
+    protected void Advance(SCR_TrafficSpawnJob job)
+    {
+        ETrafficSpawnStage previous = job.m_eStage;
+
+        switch (job.m_eStage)
+        {
+            case ETrafficSpawnStage.SPAWN_GROUP: StageSpawnGroup(job); break;
+            case ETrafficSpawnStage.SPAWN_VEHICLE: StageSpawnVehicle(job); break;
+            case ETrafficSpawnStage.SPAWN_DRIVER: StageSpawnDriver(job); break;
+            case ETrafficSpawnStage.LINK_AGENT: StageLinkAgent(job); break;
+            case ETrafficSpawnStage.SEAT_DRIVER: StageSeatDriver(job); break;
+            case ETrafficSpawnStage.WAIT_SEATED: StageWaitSeated(job); break;
+            case ETrafficSpawnStage.WAIT_GROUP: StageWaitGroup(job); break;
+        }
+
+        float now = GetTime();
+        if (job.m_eStage != previous)
+        {
+            job.m_fStageStartTime = now;
+            return;
+        }
+
+        if (now - job.m_fStageStartTime > STAGE_TIMEOUT)
+        {
+            Print(string.Format("[TRAFFIC ERROR] Spawn timed out in stage %1", typename.EnumToString(ETrafficSpawnStage, previous)), LogLevel.ERROR);
+            job.m_eStage = ETrafficSpawnStage.FAILED;
+        }
+    }
+
+    // Hands finished and failed jobs back to the manager
+    protected void FinishJobs()
+    {
+        for (int i = m_aJobs.Count() - 1; i >= 0; i--)
+        {
+            SCR_TrafficSpawnJob job = m_aJobs[i];
+            if (job.m_eStage != ETrafficSpawnStage.DONE && job.m_eStage != ETrafficSpawnStage.FAILED)
+                continue;
+
+            m_aJobs.RemoveOrdered(i);
+            if (i < m_iNextJob)
+                m_iNextJob--;
+
+            if (job.m_eStage == ETrafficSpawnStage.FAILED)
+                job.m_Unit.Delete();
+
+            m_Manager.OnSpawnJobFinished(job, job.m_eStage == ETrafficSpawnStage.DONE);
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Stages
+    // ------------------------------------------------------------------------------------------------
+    protected void StageSpawnGroup(SCR_TrafficSpawnJob job)
+    {
+        IEntity groupEnt;
+        if (m_bLocalGroups)
+            groupEnt = GetGame().SpawnEntityPrefabLocal(m_ResourceCache.Get(m_GroupPrefab), GetGame().GetWorld(), job.m_Params);
+        else
+            groupEnt = GetGame().SpawnEntityPrefab(m_ResourceCache.Get(m_GroupPrefab), GetGame().GetWorld(), job.m_Params);
+
+        SCR_AIGroup group = SCR_AIGroup.Cast(groupEnt);
+        if (!group)
+        {
+            Print("[TRAFFIC ERROR] Failed to spawn AIGroup!", LogLevel.ERROR);
+            job.m_eStage = ETrafficSpawnStage.FAILED;
+            return;
+        }
+
+        job.m_Unit.m_Group = group;
+
+        FactionManager factionMgr = GetGame().GetFactionManager();
+        if (factionMgr)
+        {
+            Faction civFaction = factionMgr.GetFactionByKey("CIV");
+            if (civFaction)
+                group.SetFaction(civFaction);
+            else
+                Print("[TRAFFIC ERROR] CIV Faction not found in FactionManager!", LogLevel.ERROR);
+        }
+
+        SCR_AIGroupUtilityComponent utility = SCR_AIGroupUtilityComponent.Cast(group.FindComponent(SCR_AIGroupUtilityComponent));
+        if (utility)
+            utility.SetCombatMode(EAIGroupCombatMode.HOLD_FIRE);
+
+        job.m_eStage = ETrafficSpawnStage.SPAWN_VEHICLE;
+    }
+
+    protected void StageSpawnVehicle(SCR_TrafficSpawnJob job)
+    {
+        IEntity vehEnt = GetGame().SpawnEntityPrefab(m_ResourceCache.Get(job.m_VehiclePrefab), GetGame().GetWorld(), job.m_Params);
+        Vehicle vehicle = Vehicle.Cast(vehEnt);
+        if (!vehicle)
+        {
+            Print("[TRAFFIC ERROR] Failed to spawn Vehicle entity!", LogLevel.ERROR);
+            job.m_eStage = ETrafficSpawnStage.FAILED;
+            return;
+        }
+
+        job.m_Unit.m_Vehicle = vehicle;
+        job.m_eStage = ETrafficSpawnStage.SPAWN_DRIVER;
+    }
+
+    protected void StageSpawnDriver(SCR_TrafficSpawnJob job)
+    {
+        IEntity drvEnt = GetGame().SpawnEntityPrefab(m_ResourceCache.Get(m_DriverPrefab), GetGame().GetWorld(), job.m_Params);
+        if (!drvEnt)
+        {
+            Print("[TRAFFIC ERROR] Failed to spawn Driver entity!", LogLevel.ERROR);
+            job.m_eStage = ETrafficSpawnStage.FAILED;
+            return;
+        }
+
+        if (!drvEnt.FindComponent(AIControlComponent))
+        {
+            Print("[TRAFFIC ERROR] Driver prefab missing AIControlComponent!", LogLevel.ERROR);
+            job.m_Unit.m_Driver = drvEnt;
+            job.m_eStage = ETrafficSpawnStage.FAILED;
+            return;
+        }
+
+        job.m_Unit.m_Driver = drvEnt;
+        job.m_eStage = ETrafficSpawnStage.LINK_AGENT;
+    }
+
+    // Waits for the driver's AI agent, then joins it to the group
+    protected void StageLinkAgent(SCR_TrafficSpawnJob job)
+    {
+        AIAgent agent = job.m_Unit.GetAgent();
+        if (!agent)
+            return;
+
+        // Full LOD while being built; SCR_TrafficDriverLOD takes over once the unit is active
+        agent.PreventMaxLOD();
+        job.m_Unit.m_Group.AddAgent(agent);
+        if (SCR_TrafficLog.IsVerbose())
+            Print(string.Format("[TRAFFIC DEBUG] Agent %1 added to Group %2", agent, job.m_Unit.m_Group), LogLevel.NORMAL);
+
+        // The agent exists now: readiness event for the observer registry, which hooks the threat system right away
+        SCR_CivilianTrafficObserver observer = SCR_CivilianTrafficObserver.Cast(job.m_Unit.m_Driver.FindComponent(SCR_CivilianTrafficObserver));
+        if (observer)
+            observer.OnAgentReady();
+
+        job.m_eStage = ETrafficSpawnStage.SEAT_DRIVER;
+    }
+
+    protected void StageSeatDriver(SCR_TrafficSpawnJob job)
+    {
+        if (!MoveDriverInVehicle(job.m_Unit.m_Vehicle, job.m_Unit.m_Driver))
+        {
+            Print("[TRAFFIC ERROR] Failed to seat driver! Check CompartmentAccessComponent.", LogLevel.ERROR);
+            job.m_eStage = ETrafficSpawnStage.FAILED;
+            return;
+        }
+
+        job.m_eStage = ETrafficSpawnStage.WAIT_SEATED;
+    }
+
+    // Once the driver is physically in the pilot seat, restart its AI so it picks up the vehicle
+    protected void StageWaitSeated(SCR_TrafficSpawnJob job)
+    {
+        SCR_ChimeraCharacter character = SCR_ChimeraCharacter.Cast(job.m_Unit.m_Driver);
+        if (!character || !character.IsInVehicle())
+            return;
+
+        if (SCR_TrafficLog.IsVerbose())
+            Print("[TRAFFIC DEBUG] Driver seated in Pilot seat successfully.", LogLevel.NORMAL);
+
+        AIAgent agent = job.m_Unit.GetAgent();
+        if (agent)
+        {
+            agent.DeactivateAI();
+            agent.ActivateAI();
+        }
+
+        job.m_eStage = ETrafficSpawnStage.WAIT_GROUP;
+    }
+
+    protected void StageWaitGroup(SCR_TrafficSpawnJob job)
+    {
+        if (job.m_Unit.m_Group.GetAgentsCount() > 0)
+        {
+            job.m_Unit.CacheComponents();
+            job.m_eStage = ETrafficSpawnStage.DONE;
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected bool MoveDriverInVehicle(Vehicle vehicle, IEntity driver)
+    {
+        BaseCompartmentManagerComponent compMgr = BaseCompartmentManagerComponent.Cast(vehicle.FindComponent(BaseCompartmentManagerComponent));
+        CompartmentAccessComponent access = CompartmentAccessComponent.Cast(driver.FindComponent(CompartmentAccessComponent));
+        if (!compMgr || !access) return false;
+
+        array<BaseCompartmentSlot> compartments = {};
+        compMgr.GetCompartments(compartments);
+
+        foreach (BaseCompartmentSlot slot : compartments)
+        {
+            if (slot.GetType() == ECompartmentType.PILOT)
+                return access.GetInVehicle(vehicle, slot, true, -1, ECloseDoorAfterActions.INVALID, false);
+        }
+        return false;
+    }
+
+    protected float GetTime()
+    {
+        return GetGame().GetWorld().GetWorldTime() / 1000.0;
+    }
+}
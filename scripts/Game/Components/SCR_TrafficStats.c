@@ -0,0 +1,357 @@
+enum ETrafficPhase
+{
+    TICK,
+    SNAPSHOT,
+    GOVERNOR,
+    VISIBILITY,
+    CLEANUP,
+    DRIVER_LOD,
+    BALANCE,
+    RELEVANCE,
+    VIRTUAL,
+    PARKED,
+    ROAD_QUERY,
+    SPAWN_STAGES,
+    PARKED_SPAWNS,
+    // Waypoint pool sweep only; assigning a waypoint is part of the phase that does it, so no
+    // phase is nested in another and the per-phase times add up
+    WAYPOINTS
+}
+
+enum ETrafficCounter
+{
+    SPAWN_ATTEMPTS,
+    SPAWN_SEARCH_FAILURES,
+    SPAWN_JOB_FAILURES,
+    SPAWNED,
+    RECYCLED,
+    DESPAWNED,
+    WAYPOINTS,
+    TRACES,
+    LEGS,
+    PANIC_REACTIONS,
+    STREAM_SWITCHES
+}
+
+// ------------------------------------------------------------------------------------------------
+// Runtime switch for chatty per-spawn and per-event logging. Hot paths check IsVerbose() before
+// formatting anything, so the default costs one static read.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficLog
+{
+    protected static bool s_bVerbose;
+
+    static void SetVerbose(bool verbose)
+    {
+        s_bVerbose = verbose;
+    }
+
+    static bool IsVerbose()
+    {
+        return s_bVerbose;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Per-phase timing and counters for the traffic loop. Phases are timed with the engine tick count
+// (1 ms resolution), so single samples are coarse but period sums and averages are meaningful.
+// Every report interval the period is logged as one aggregated line, optionally written as JSON
+// to the profile directory, and kept as text lines for the admin overlay.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficStats
+{
+    protected const int PHASE_COUNT = 14;
+    static const int COUNTER_COUNT = 11;
+    protected const string STATS_DIRECTORY = "$profile:GRAD_Traffic";
+    protected const string STATS_FILE = "$profile:GRAD_Traffic/stats.json";
+
+    protected int m_iReportInterval = 60;
+    protected bool m_bWriteFile;
+    protected int m_iTicksInPeriod;
+
+    protected ref array<int> m_aPhaseStart = {};
+    protected ref array<int> m_aPeriodMs = {};
+    protected ref array<int> m_aPeriodMaxMs = {};
+    protected ref array<int> m_aPeriodCalls = {};
+    protected ref array<int> m_aTotalMs = {};
+    protected ref array<int> m_aLastMs = {};
+    protected ref array<int> m_aPeriodCounters = {};
+    protected ref array<int> m_aTotalCounters = {};
+
+    // Gauges, overwritten every tick by the manager
+    protected int m_iActive;
+    protected int m_iInFlight;
+    protected int m_iPooled;
+    protected int m_iTokens;
+    protected int m_iCap;
+    protected int m_iWaypoints;
+    protected int m_iParked;
+
+    // Cars streamed to each client in the last tick, and their estimated cost
+    protected ref array<int> m_aClientIds = {};
+    protected ref array<int> m_aClientCars = {};
+    protected float m_fBytesPerCar;
+    protected int m_iPeriodPeakCars;
+
+    protected ref array<string> m_aLastReport = {};
+
+    // ------------------------------------------------------------------------------------------------
+    void SCR_TrafficStats()
+    {
+        for (int i = 0; i < PHASE_COUNT; i++)
+        {
+            m_aPhaseStart.Insert(0);
+            m_aPeriodMs.Insert(0);
+            m_aPeriodMaxMs.Insert(0);
+            m_aPeriodCalls.Insert(0);
+            m_aTotalMs.Insert(0);
+            m_aLastMs.Insert(0);
+        }
+
+        for (int i = 0; i < COUNTER_COUNT; i++)
+        {
+            m_aPeriodCounters.Insert(0);
+            m_aTotalCounters.Insert(0);
+        }
+    }
+
+    // interval in seconds (= loop ticks); 0 disables the periodic log and file
+    void Configure(int reportInterval, bool writeFile)
+    {
+        m_iReportInterval = Math.Max(0, reportInterval);
+        m_bWriteFile = writeFile;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    void BeginPhase(ETrafficPhase phase)
+    {
+        m_aPhaseStart[phase] = System.GetTickCount();
+    }
+
+    void EndPhase(ETrafficPhase phase)
+    {
+        int elapsed = System.GetTickCount() - m_aPhaseStart[phase];
+        m_aPeriodMs[phase] = m_aPeriodMs[phase] + elapsed;
+        m_aPeriodMaxMs[phase] = Math.Max(m_aPeriodMaxMs[phase], elapsed);
+        m_aPeriodCalls[phase] = m_aPeriodCalls[phase] + 1;
+        m_aTotalMs[phase] = m_aTotalMs[phase] + elapsed;
+        m_aLastMs[phase] = elapsed;
+    }
+
+    // Duration of the most recent run of a phase
+    int GetLastMs(ETrafficPhase phase)
+    {
+        return m_aLastMs[phase];
+    }
+
+    int GetTotalMs(ETrafficPhase phase)
+    {
+        return m_aTotalMs[phase];
+    }
+
+    void Count(ETrafficCounter counter, int amount = 1)
+    {
+        m_aPeriodCounters[counter] = m_aPeriodCounters[counter] + amount;
+        m_aTotalCounters[counter] = m_aTotalCounters[counter] + amount;
+    }
+
+    int GetTotal(ETrafficCounter counter)
+    {
+        return m_aTotalCounters[counter];
+    }
+
+    void SetGauges(int active, int inFlight, int pooled, int tokens, int cap)
+    {
+        m_iActive = active;
+        m_iInFlight = inFlight;
+        m_iPooled = pooled;
+        m_iTokens = tokens;
+        m_iCap = cap;
+    }
+
+    void SetWaypointGauge(int liveWaypoints)
+    {
+        m_iWaypoints = liveWaypoints;
+    }
+
+    void SetParkedGauge(int parked)
+    {
+        m_iParked = parked;
+    }
+
+    void SetNetworkGauges(notnull array<int> clientIds, notnull array<int> clientCars, float bytesPerCar)
+    {
+        m_aClientIds.Copy(clientIds);
+        m_aClientCars.Copy(clientCars);
+        m_fBytesPerCar = bytesPerCar;
+
+        foreach (int cars : m_aClientCars)
+            m_iPeriodPeakCars = Math.Max(m_iPeriodPeakCars, cars);
+    }
+
+    // Estimated traffic bandwidth of a client receiving this many cars, in KB/s
+    static string FormatKilobytes(int cars, float bytesPerCar)
+    {
+        float kilobytes = cars * bytesPerCar;
+        kilobytes /= 1024;
+        return kilobytes.ToString(-1, 1);
+    }
+
+    // Called once per loop tick after all phases; closes the period when the interval is reached
+    void EndTick()
+    {
+        m_iTicksInPeriod++;
+        if (m_iReportInterval == 0 || m_iTicksInPeriod < m_iReportInterval)
+            return;
+
+        Report();
+        ResetPeriod();
+    }
+
+    // Live gauges followed by the last closed period, newline separated, for the admin overlay
+    string FormatOverlay()
+    {
+        string text = FormatGauges();
+        for (int i = 1; i < m_aLastReport.Count(); i++)
+            text += "\n" + m_aLastReport[i];
+
+        return text;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected void Report()
+    {
+        m_aLastReport.Clear();
+        m_aLastReport.Insert(FormatGauges());
+        m_aLastReport.Insert(string.Format("Tick avg %1 ms, max %2 ms over %3 s", FormatAverage(ETrafficPhase.TICK), m_aPeriodMaxMs[ETrafficPhase.TICK], m_iTicksInPeriod));
+
+        string phases = "Phases (ms/tick):";
+        for (int i = ETrafficPhase.SNAPSHOT; i < PHASE_COUNT; i++)
+            phases += string.Format(" %1 %2", GetPhaseName(i), FormatPerTick(i));
+
+        m_aLastReport.Insert(phases);
+        m_aLastReport.Insert(string.Format("Spawns %1 tried, %2 spawned, %3 recycled, %4 no road point, %5 failed builds",
+            m_aPeriodCounters[ETrafficCounter.SPAWN_ATTEMPTS], m_aPeriodCounters[ETrafficCounter.SPAWNED], m_aPeriodCounters[ETrafficCounter.RECYCLED],
+            m_aPeriodCounters[ETrafficCounter.SPAWN_SEARCH_FAILURES], m_aPeriodCounters[ETrafficCounter.SPAWN_JOB_FAILURES]));
+        m_aLastReport.Insert(string.Format("Despawns %1 | legs chained %2 | panic reactions %3 | waypoints %4 | visibility traces %5",
+            m_aPeriodCounters[ETrafficCounter.DESPAWNED], m_aPeriodCounters[ETrafficCounter.LEGS], m_aPeriodCounters[ETrafficCounter.PANIC_REACTIONS],
+            m_aPeriodCounters[ETrafficCounter.WAYPOINTS], m_aPeriodCounters[ETrafficCounter.TRACES]));
+        m_aLastReport.Insert(string.Format("Network: %1 clients, %2 cars/client now, peak %3 cars (~%4 KB/s est.) | %5 streaming switches",
+            m_aClientCars.Count(), FormatAverageCars(), m_iPeriodPeakCars, FormatKilobytes(m_iPeriodPeakCars, m_fBytesPerCar), m_aPeriodCounters[ETrafficCounter.STREAM_SWITCHES]));
+
+        foreach (string line : m_aLastReport)
+            Print("[TRAFFIC STATS] " + line, LogLevel.NORMAL);
+
+        if (m_bWriteFile)
+            WriteFile();
+    }
+
+    // Overwritten every period: the last period plus lifetime totals
+    protected void WriteFile()
+    {
+        FileIO.MakeDirectory(STATS_DIRECTORY);
+
+        FileHandle file = FileIO.OpenFile(STATS_FILE, FileMode.WRITE);
+        if (!file)
+        {
+            Print(string.Format("[TRAFFIC] Could not write stats file %1", STATS_FILE), LogLevel.WARNING);
+            return;
+        }
+
+        file.WriteLine("{");
+        file.WriteLine(string.Format("  \"worldTimeS\": %1,", GetGame().GetWorld().GetWorldTime() / 1000.0));
+        file.WriteLine(string.Format("  \"periodTicks\": %1,", m_iTicksInPeriod));
+        file.WriteLine(string.Format("  \"active\": %1, \"cap\": %2, \"inFlight\": %3, \"pooled\": %4, \"virtual\": %5, \"waypoints\": %6, \"parked\": %7,", m_iActive, m_iCap, m_iInFlight, m_iPooled, m_iTokens, m_iWaypoints, m_iParked));
+
+        file.WriteLine("  \"phases\": {");
+        for (int i = 0; i < PHASE_COUNT; i++)
+        {
+            string separator = ",";
+            if (i == PHASE_COUNT - 1)
+                separator = "";
+
+            file.WriteLine(string.Format("    \"%1\": { \"periodMs\": %2, \"maxMs\": %3, \"calls\": %4, \"totalMs\": %5 }%6",
+                GetPhaseName(i), m_aPeriodMs[i], m_aPeriodMaxMs[i], m_aPeriodCalls[i], m_aTotalMs[i], separator));
+        }
+        file.WriteLine("  },");
+
+        file.WriteLine(string.Format("  \"network\": { \"bytesPerCar\": %1, \"periodPeakCars\": %2, \"clients\": [", m_fBytesPerCar, m_iPeriodPeakCars));
+        for (int i = 0; i < m_aClientIds.Count(); i++)
+        {
+            string separator = ",";
+            if (i == m_aClientIds.Count() - 1)
+                separator = "";
+
+            file.WriteLine(string.Format("    { \"player\": %1, \"cars\": %2, \"estBytesPerSec\": %3 }%4",
+                m_aClientIds[i], m_aClientCars[i], m_aClientCars[i] * m_fBytesPerCar, separator));
+        }
+        file.WriteLine("  ] },");
+
+        file.WriteLine("  \"counters\": {");
+        for (int i = 0; i < COUNTER_COUNT; i++)
+        {
+            string separator = ",";
+            if (i == COUNTER_COUNT - 1)
+                separator = "";
+
+            file.WriteLine(string.Format("    \"%1\": { \"period\": %2, \"total\": %3 }%4",
+                typename.EnumToString(ETrafficCounter, i), m_aPeriodCounters[i], m_aTotalCounters[i], separator));
+        }
+        file.WriteLine("  }");
+        file.WriteLine("}");
+
+        file.Close();
+    }
+
+    protected void ResetPeriod()
+    {
+        m_iTicksInPeriod = 0;
+        for (int i = 0; i < PHASE_COUNT; i++)
+        {
+            m_aPeriodMs[i] = 0;
+            m_aPeriodMaxMs[i] = 0;
+            m_aPeriodCalls[i] = 0;
+        }
+
+        for (int i = 0; i < COUNTER_COUNT; i++)
+            m_aPeriodCounters[i] = 0;
+
+        m_iPeriodPeakCars = 0;
+    }
+
+    protected string FormatGauges()
+    {
+        return string.Format("Traffic %1/%2 active | %3 in flight | %4 pooled | %5 virtual | %6 waypoints | %7 parked", m_iActive, m_iCap, m_iInFlight, m_iPooled, m_iTokens, m_iWaypoints, m_iParked);
+    }
+
+    protected string FormatAverageCars()
+    {
+        float clients = Math.Max(1, m_aClientCars.Count());
+        float total = 0;
+        foreach (int cars : m_aClientCars)
+            total += cars;
+
+        return (total / clients).ToString(-1, 1);
+    }
+
+    protected string GetPhaseName(int phase)
+    {
+        string name = typename.EnumToString(ETrafficPhase, phase);
+        name.ToLower();
+        return name;
+    }
+
+    // Average per call, for phases that run once per tick
+    protected string FormatAverage(int phase)
+    {
+        float calls = Math.Max(1, m_aPeriodCalls[phase]);
+        return (m_aPeriodMs[phase] / calls).ToString(-1, 2);
+    }
+
+    // Cost spread over the period's ticks, so phases that run outside the loop compare fairly
+    protected string FormatPerTick(int phase)
+    {
+        float ticks = Math.Max(1, m_iTicksInPeriod);
+        return (m_aPeriodMs[phase] / ticks).ToString(-1, 2);
+    }
+}
@@ -0,0 +1,116 @@
+// ------------------------------------------------------------------------------------------------
+// Admin / Game Master overlay for the traffic stats. Only active when the mission header has
+// m_bShowDebugMarkers set: the local controller polls the server every few seconds, the server
+// answers only to admins and Game Masters, and the text is drawn with DbgUI every frame. Anyone
+// else gets one refusal that stops the polling; it is asked again after the next respawn, in case
+// a role was granted meanwhile.
+// ------------------------------------------------------------------------------------------------
+modded class SCR_PlayerController
+{
+    protected static const int TRAFFIC_STATS_POLL_MS = 2000;
+
+    protected ref array<string> m_aTrafficStatsLines = {};
+    protected bool m_bTrafficOverlayStarted;
+
+    override void OnControlledEntityChanged(IEntity from, IEntity to)
+    {
+        super.OnControlledEntityChanged(from, to);
+
+        if (m_bTrafficOverlayStarted || !to || GetGame().GetPlayerController() != this)
+            return;
+
+        SCR_MissionHeader header = SCR_MissionHeader.Cast(GetGame().GetMissionHeader());
+        if (!header || !header.m_bShowDebugMarkers)
+            return;
+
+        m_bTrafficOverlayStarted = true;
+        GetGame().GetCallqueue().CallLater(RequestTrafficStats, TRAFFIC_STATS_POLL_MS, true);
+        GetGame().GetCallqueue().CallLater(DrawTrafficStats, 0, true);
+    }
+
+    // Stops polling and drawing; called when the game or the traffic manager shuts down
+    void StopTrafficOverlay()
+    {
+        if (!m_bTrafficOverlayStarted)
+            return;
+
+        m_bTrafficOverlayStarted = false;
+        m_aTrafficStatsLines.Clear();
+
+        ScriptCallQueue queue = GetGame().GetCallqueue();
+        if (!queue)
+            return;
+
+        queue.Remove(RequestTrafficStats);
+        queue.Remove(DrawTrafficStats);
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected void RequestTrafficStats()
+    {
+        Rpc(RpcAsk_TrafficStats);
+    }
+
+    [RplRpc(RplChannel.Reliable, RplRcver.Server)]
+    protected void RpcAsk_TrafficStats()
+    {
+        // Told once, so a player without the role does not keep polling for the whole session
+        if (!CanSeeTrafficStats())
+        {
+            Rpc(RpcDo_TrafficStatsDenied);
+            return;
+        }
+
+        SCR_AmbientTrafficManager manager = SCR_AmbientTrafficManager.GetInstance();
+        if (!manager)
+            return;
+
+        string text = manager.GetStats().FormatOverlay();
+        text += string.Format("\nDensity: %1", manager.GetDensityReason());
+        text += "\n" + manager.GetClusterSummary();
+        text += "\n" + manager.GetNetworkSummary(GetPlayerId());
+
+        string parked = manager.GetParkedSummary();
+        if (!parked.IsEmpty())
+            text += "\n" + parked;
+        Rpc(RpcDo_TrafficStats, text);
+    }
+
+    [RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+    protected void RpcDo_TrafficStats(string text)
+    {
+        m_aTrafficStatsLines.Clear();
+        text.Split("\n", m_aTrafficStatsLines, true);
+    }
+
+    [RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+    protected void RpcDo_TrafficStatsDenied()
+    {
+        StopTrafficOverlay();
+    }
+
+    // Local play has no roles to check
+    protected bool CanSeeTrafficStats()
+    {
+        if (!Replication.IsRunning())
+            return true;
+
+        PlayerManager playerMgr = GetGame().GetPlayerManager();
+        int playerId = GetPlayerId();
+        return playerMgr.HasPlayerRole(playerId, EPlayerRole.ADMINISTRATOR)
+            || playerMgr.HasPlayerRole(playerId, EPlayerRole.SESSION_ADMINISTRATOR)
+            || playerMgr.HasPlayerRole(playerId, EPlayerRole.GAME_MASTER);
+    }
+
+    protected void DrawTrafficStats()
+    {
+        if (m_aTrafficStatsLines.IsEmpty())
+            return;
+
+        DbgUI.Begin("GRAD Traffic", 10, 200);
+        foreach (string line : m_aTrafficStatsLines)
+            DbgUI.Text(line);
+
+        DbgUI.End();
+    }
+}
@@ -0,0 +1,103 @@
+enum ETrafficProgressVerdict
+{
+    OK,
+    REROUTE,
+    RECYCLE
+}
+
+// ------------------------------------------------------------------------------------------------
+// Watches each active unit for progress towards its destination. A unit that has not got
+// meaningfully closer within the window is first given a new route; if it still makes no
+// progress in the following window it is reported for recycling, which the manager does once
+// nobody can see it. Counts how many slots were won back this way.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficStuckMonitor
+{
+    protected const int MAX_REROUTES = 1;
+
+    protected float m_fWindow = 90.0;
+    protected float m_fMinProgress = 25.0;
+
+    // Lifetime counters
+    protected int m_iReroutesTotal;
+    protected int m_iRecycledTotal;
+
+    // ------------------------------------------------------------------------------------------------
+    void Configure(float window, float minProgress)
+    {
+        m_fWindow = Math.Max(10.0, window);
+        m_fMinProgress = Math.Max(1.0, minProgress);
+    }
+
+    // Starts a fresh window, e.g. when the unit is activated or got a new destination
+    void Track(SCR_TrafficUnit unit, vector pos)
+    {
+        unit.m_fProgressBestDistance = vector.DistanceXZ(pos, unit.m_vDestination);
+        unit.m_fProgressSince = GetTime();
+        unit.m_bStuck = false;
+    }
+
+    void ResetReroutes(SCR_TrafficUnit unit)
+    {
+        unit.m_iReroutes = 0;
+    }
+
+    ETrafficProgressVerdict Evaluate(SCR_TrafficUnit unit, vector pos)
+    {
+        if (unit.m_bStuck)
+            return ETrafficProgressVerdict.RECYCLE;
+
+        float now = GetTime();
+        float dist = vector.DistanceXZ(pos, unit.m_vDestination);
+        if (dist < unit.m_fProgressBestDistance - m_fMinProgress)
+        {
+            unit.m_fProgressBestDistance = dist;
+            unit.m_fProgressSince = now;
+            return ETrafficProgressVerdict.OK;
+        }
+
+        if (now - unit.m_fProgressSince < m_fWindow)
+            return ETrafficProgressVerdict.OK;
+
+        if (unit.m_iReroutes < MAX_REROUTES)
+            return ETrafficProgressVerdict.REROUTE;
+
+        unit.m_bStuck = true;
+        return ETrafficProgressVerdict.RECYCLE;
+    }
+
+    // The manager reports what it did with a verdict so the counters reflect real outcomes
+    void RecordReroute(SCR_TrafficUnit unit, vector pos)
+    {
+        unit.m_iReroutes++;
+        m_iReroutesTotal++;
+        Track(unit, pos);
+    }
+
+    // A reroute was due but not possible (no seated driver, no road nearby): skip straight to recycling
+    void MarkStuck(SCR_TrafficUnit unit)
+    {
+        unit.m_bStuck = true;
+    }
+
+    void RecordRecycled()
+    {
+        m_iRecycledTotal++;
+    }
+
+    int GetReroutesTotal()
+    {
+        return m_iReroutesTotal;
+    }
+
+    int GetRecycledTotal()
+    {
+        return m_iRecycledTotal;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected float GetTime()
+    {
+        return GetGame().GetWorld().GetWorldTime() / 1000.0;
+    }
+}
@@ -0,0 +1,131 @@
+// ------------------------------------------------------------------------------------------------
+// One traffic car: the vehicle, its driver and the AI group, tracked together so the set can be
+// despawned, parked in the pool and recycled as a whole.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficUnit : Managed
+{
+    Vehicle m_Vehicle;
+    IEntity m_Driver;
+    SCR_AIGroup m_Group;
+    vector m_vDestination;
+
+    // Key into the manager's active-vehicle grid (-1 = not indexed)
+    int m_iId = -1;
+    int m_iCellKey;
+
+    // Looked up once by CacheComponents() when the unit is built
+    DamageManagerComponent m_VehicleDamage;
+    DamageManagerComponent m_DriverDamage;
+    SCR_CivilianTrafficObserver m_Observer;
+    RplComponent m_VehicleRpl;
+
+    // AI LOD currently applied by SCR_TrafficDriverLOD (-1 = not managed yet)
+    int m_iAILOD = -1;
+    float m_fLODPinnedUntil;
+
+    // Last result from SCR_TrafficVisibilityService (-1 = never checked)
+    bool m_bVisible;
+    float m_fVisibilityCheckedAt = -1;
+    bool m_bVisibilityQueued;
+
+    // Per player id: whether SCR_TrafficRelevance last streamed the car in (true) or out (false)
+    ref map<int, bool> m_mStreamedTo = new map<int, bool>();
+
+    // Player cluster the car counts towards, set each tick by SCR_TrafficClusterBalancer (-1 = none)
+    int m_iCluster = -1;
+
+    // Progress tracking by SCR_TrafficStuckMonitor
+    float m_fProgressBestDistance;
+    float m_fProgressSince;
+    int m_iReroutes;
+    bool m_bStuck;
+
+    // ------------------------------------------------------------------------------------------------
+    AIAgent GetAgent()
+    {
+        if (!m_Driver)
+            return null;
+
+        AIControlComponent aiControl = AIControlComponent.Cast(m_Driver.FindComponent(AIControlComponent));
+        if (!aiControl)
+            return null;
+
+        return aiControl.GetControlAIAgent();
+    }
+
+    void CacheComponents()
+    {
+        if (m_Vehicle)
+        {
+            m_VehicleDamage = DamageManagerComponent.Cast(m_Vehicle.FindComponent(DamageManagerComponent));
+            m_VehicleRpl = RplComponent.Cast(m_Vehicle.FindComponent(RplComponent));
+        }
+
+        if (m_Driver)
+        {
+            m_DriverDamage = DamageManagerComponent.Cast(m_Driver.FindComponent(DamageManagerComponent));
+            m_Observer = SCR_CivilianTrafficObserver.Cast(m_Driver.FindComponent(SCR_CivilianTrafficObserver));
+        }
+    }
+
+    bool IsVehicleDestroyed()
+    {
+        return m_VehicleDamage && m_VehicleDamage.GetState() == EDamageState.DESTROYED;
+    }
+
+    // All three entities still exist and neither car nor driver is destroyed
+    bool IsIntact()
+    {
+        if (!m_Vehicle || !m_Driver || !m_Group)
+            return false;
+
+        if (IsVehicleDestroyed())
+            return false;
+
+        if (m_DriverDamage && m_DriverDamage.GetState() == EDamageState.DESTROYED)
+            return false;
+
+        return true;
+    }
+
+    // The driver is reacting to a civilian incident (stopped or fleeing), see SCR_CivilianTrafficObserver
+    bool IsPanicked()
+    {
+        return m_Observer && m_Observer.IsPanicked();
+    }
+
+    // Removes every waypoint the group still holds; pool waypoints go back to the pool, others are
+    // only detached. Without a running pool (shutdown) the pool deletes its own waypoints itself.
+    void ClearWaypoints()
+    {
+        if (!m_Group)
+            return;
+
+        SCR_TrafficWaypointPool pool = SCR_AmbientTrafficManager.GetWaypointPool();
+        if (pool)
+        {
+            pool.ClearGroup(m_Group);
+            return;
+        }
+
+        array<AIWaypoint> waypoints = {};
+        m_Group.GetWaypoints(waypoints);
+        foreach (AIWaypoint wp : waypoints)
+            m_Group.RemoveWaypoint(wp);
+    }
+
+    void Delete()
+    {
+        ClearWaypoints();
+
+        if (m_Vehicle)
+            SCR_EntityHelper.DeleteEntityAndChildren(m_Vehicle);
+
+        // Driver is normally deleted with the vehicle as a child; catch the case where it got out
+        if (m_Driver)
+            SCR_EntityHelper.DeleteEntityAndChildren(m_Driver);
+
+        if (m_Group)
+            SCR_EntityHelper.DeleteEntityAndChildren(m_Group);
+    }
+}
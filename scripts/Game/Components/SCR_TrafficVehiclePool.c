@@ -0,0 +1,191 @@
+// ------------------------------------------------------------------------------------------------
+// Pool of parked traffic units. A despawned car keeps its driver seated and its group intact;
+// it is moved to a parking slot below the far map corner (which also streams it out for every
+// client), hidden, frozen and its AI switched off. Recycling moves it back onto a road.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficVehiclePool
+{
+    protected const float PARKING_DEPTH = 1000.0;
+    protected const float PARKING_SPACING = 25.0;
+
+    protected ref array<ref SCR_TrafficUnit> m_aParked = {};
+    // Parking slot of each parked unit, indexed like m_aParked; slots freed by Take() are reused
+    protected ref array<int> m_aParkedSlots = {};
+    protected ref array<int> m_aFreeSlots = {};
+    protected int m_iSlotCount;
+    protected int m_iCapacity;
+
+    // Lifetime counters
+    protected int m_iParkedTotal;
+    protected int m_iRecycledTotal;
+
+    // ------------------------------------------------------------------------------------------------
+    void SetCapacity(int capacity)
+    {
+        m_iCapacity = Math.Max(0, capacity);
+    }
+
+    int GetCapacity()
+    {
+        return m_iCapacity;
+    }
+
+    int GetCount()
+    {
+        return m_aParked.Count();
+    }
+
+    bool HasRoom()
+    {
+        return m_aParked.Count() < m_iCapacity;
+    }
+
+    int GetParkedTotal()
+    {
+        return m_iParkedTotal;
+    }
+
+    int GetRecycledTotal()
+    {
+        return m_iRecycledTotal;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Returns false when the pool is full or the unit is damaged; the caller then deletes it.
+    // An admitted car is streamed out of every client through relevance (when given) before it is
+    // moved, so no client sees it travel to the parking slot.
+    bool Park(SCR_TrafficUnit unit, SCR_TrafficRelevance relevance = null)
+    {
+        if (!unit || !HasRoom() || !unit.IsIntact())
+            return false;
+
+        if (relevance)
+            relevance.Withdraw(unit);
+
+        unit.ClearWaypoints();
+
+        AIAgent agent = unit.GetAgent();
+        if (agent)
+            agent.DeactivateAI();
+
+        unit.m_iAILOD = -1;
+        unit.m_fLODPinnedUntil = 0;
+        unit.m_fVisibilityCheckedAt = -1;
+
+        Vehicle vehicle = unit.m_Vehicle;
+        CarControllerComponent carController = CarControllerComponent.Cast(vehicle.FindComponent(CarControllerComponent));
+        if (carController)
+        {
+            carController.StopEngine();
+            carController.SetPersistentHandBrake(true);
+        }
+
+        int slot = AcquireSlot();
+        vector mat[4];
+        vehicle.GetWorldTransform(mat);
+        mat[3] = GetSlotPosition(slot);
+        vehicle.SetWorldTransform(mat);
+
+        Physics physics = vehicle.GetPhysics();
+        if (physics)
+        {
+            physics.SetVelocity(vector.Zero);
+            physics.SetAngularVelocity(vector.Zero);
+            physics.SetActive(ActiveState.INACTIVE);
+        }
+
+        vehicle.ClearFlags(EntityFlags.VISIBLE, true);
+
+        m_aParked.Insert(unit);
+        m_aParkedSlots.Insert(slot);
+        m_iParkedTotal++;
+        return true;
+    }
+
+    // Hands out a parked unit that is still intact, or null. Broken ones are deleted on the way.
+    SCR_TrafficUnit Take()
+    {
+        while (!m_aParked.IsEmpty())
+        {
+            int last = m_aParked.Count() - 1;
+            SCR_TrafficUnit unit = m_aParked[last];
+            m_aParked.Remove(last);
+            m_aFreeSlots.Insert(m_aParkedSlots[last]);
+            m_aParkedSlots.Remove(last);
+
+            if (unit.IsIntact())
+            {
+                m_iRecycledTotal++;
+                return unit;
+            }
+
+            unit.Delete();
+        }
+
+        return null;
+    }
+
+    // Places a unit taken from the pool at the spawn transform and wakes it up.
+    // Engine start and waypoint assignment stay with the caller, same as for fresh units.
+    void Unpark(SCR_TrafficUnit unit, EntitySpawnParams params)
+    {
+        Vehicle vehicle = unit.m_Vehicle;
+        vehicle.SetWorldTransform(params.Transform);
+        vehicle.SetFlags(EntityFlags.VISIBLE, true);
+
+        Physics physics = vehicle.GetPhysics();
+        if (physics)
+        {
+            physics.SetActive(ActiveState.ACTIVE);
+            physics.SetVelocity(vector.Zero);
+            physics.SetAngularVelocity(vector.Zero);
+        }
+
+        AIAgent agent = unit.GetAgent();
+        if (agent)
+            agent.ActivateAI();
+    }
+
+    void Clear()
+    {
+        foreach (SCR_TrafficUnit unit : m_aParked)
+            unit.Delete();
+
+        m_aParked.Clear();
+        m_aParkedSlots.Clear();
+        m_aFreeSlots.Clear();
+        m_iSlotCount = 0;
+    }
+
+    // Where pool warm-up spawns a car before it is parked: one spacing before the first slot, so it
+    // never lands on a parked unit. Warm-up has a single car in flight at a time.
+    vector GetStagingPosition()
+    {
+        return GetSlotPosition(-1);
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // A slot no parked unit holds: a freed one if any, otherwise the next new one
+    protected int AcquireSlot()
+    {
+        if (!m_aFreeSlots.IsEmpty())
+        {
+            int last = m_aFreeSlots.Count() - 1;
+            int slot = m_aFreeSlots[last];
+            m_aFreeSlots.Remove(last);
+            return slot;
+        }
+
+        int newSlot = m_iSlotCount;
+        m_iSlotCount++;
+        return newSlot;
+    }
+
+    protected vector GetSlotPosition(int slot)
+    {
+        vector mapMin, mapMax;
+        GetGame().GetWorldEntity().GetWorldBounds(mapMin, mapMax);
+
+        return Vector(mapMin[0] + slot * PARKING_SPACING, mapMin[1] - PARKING_DEPTH, mapMin[2]);
+    }
+}
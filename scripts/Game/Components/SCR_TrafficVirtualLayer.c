@@ -0,0 +1,286 @@
+// ------------------------------------------------------------------------------------------------
+// An entity-less car: where it is on the road index, which way it is going and where to.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficToken
+{
+    int m_iId;
+    int m_iPoint;
+    int m_iStep = 1;
+    int m_iDestPoint;
+    float m_fTravel;
+    int m_iCellKey;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Virtual traffic beyond player range. Tokens drive along the sampled road index at a nominal
+// speed without any entities; SCR_AmbientTrafficManager turns a token into a real car when it
+// enters the player ring and turns a despawned car back into a token, so the map keeps a steady
+// traffic population for the price of a few arrays.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficVirtualLayer
+{
+    protected const float DEFAULT_SPEED = 12.0;
+    protected const float ARRIVAL_RADIUS = 100.0;
+    protected const float GRID_CELL_SIZE = 500.0;
+    protected const float MIN_DESTINATION_DISTANCE = 2000.0;
+    protected const int PICK_ATTEMPTS = 8;
+    protected const float SNAP_RADIUS = 100.0;
+
+    protected SCR_TrafficRoadIndex m_RoadIndex;
+    protected int m_iTargetPopulation;
+    protected float m_fSpeed = DEFAULT_SPEED;
+
+    protected ref map<int, ref SCR_TrafficToken> m_mTokens = new map<int, ref SCR_TrafficToken>();
+    protected ref SCR_TrafficSpatialGrid m_Grid = new SCR_TrafficSpatialGrid(GRID_CELL_SIZE);
+    protected int m_iNextId;
+
+    protected ref array<int> m_aQueryBuffer = {};
+    protected ref array<int> m_aJunctionBuffer = {};
+
+    // ------------------------------------------------------------------------------------------------
+    void SCR_TrafficVirtualLayer(SCR_TrafficRoadIndex roadIndex)
+    {
+        m_RoadIndex = roadIndex;
+    }
+
+    // targetPopulation counts virtual and real cars together; 0 disables the layer
+    void SetTargetPopulation(int targetPopulation)
+    {
+        m_iTargetPopulation = Math.Max(0, targetPopulation);
+    }
+
+    // Seeds the whole population at random spawnable road points in one go
+    void Populate()
+    {
+        if (!IsEnabled())
+            return;
+
+        for (int i = m_mTokens.Count(); i < m_iTargetPopulation; i++)
+        {
+            int pointId = m_RoadIndex.GetRandomSpawnablePoint(PICK_ATTEMPTS);
+            if (pointId != -1)
+                AddToken(pointId, -1);
+        }
+
+        Print(string.Format("[TRAFFIC] Virtual traffic seeded with %1 tokens", m_mTokens.Count()), LogLevel.NORMAL);
+    }
+
+    // Nominal driving speed in m/s
+    void SetSpeed(float speed)
+    {
+        m_fSpeed = Math.Max(0, speed);
+    }
+
+    bool IsEnabled()
+    {
+        return m_iTargetPopulation > 0 && m_RoadIndex.IsBuilt();
+    }
+
+    int GetTokenCount()
+    {
+        return m_mTokens.Count();
+    }
+
+    void Clear()
+    {
+        m_mTokens.Clear();
+        m_Grid.Clear();
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Moves every token by dt seconds of driving and tops the population back up to target
+    // (realCount cars currently exist as entities).
+    void Update(float dt, int realCount)
+    {
+        if (!IsEnabled())
+            return;
+
+        float distance = m_fSpeed * dt;
+        foreach (int id, SCR_TrafficToken token : m_mTokens)
+        {
+            Advance(token, distance);
+            token.m_iCellKey = m_Grid.Move(token.m_iCellKey, m_RoadIndex.GetPosition(token.m_iPoint), token.m_iId);
+        }
+
+        // One new token per tick at most; destroyed cars are replaced gradually
+        if (m_mTokens.Count() + realCount < m_iTargetPopulation)
+        {
+            int pointId = m_RoadIndex.GetRandomSpawnablePoint(PICK_ATTEMPTS);
+            if (pointId != -1)
+                AddToken(pointId, -1);
+        }
+    }
+
+    // Tokens whose XZ distance to center lies in [minRadius, maxRadius]
+    void QueryRing(vector center, float minRadius, float maxRadius, notnull array<int> outIds)
+    {
+        m_aQueryBuffer.Clear();
+        m_Grid.Query(center, maxRadius, m_aQueryBuffer);
+
+        float minSq = minRadius * minRadius;
+        float maxSq = maxRadius * maxRadius;
+        foreach (int id : m_aQueryBuffer)
+        {
+            SCR_TrafficToken token = m_mTokens.Get(id);
+            if (!token)
+                continue;
+
+            float distSq = vector.DistanceSqXZ(center, m_RoadIndex.GetPosition(token.m_iPoint));
+            if (distSq >= minSq && distSq <= maxSq)
+                outIds.Insert(id);
+        }
+    }
+
+    // Position and direction of travel of every token, in token id order
+    void GetTokenPoses(notnull array<vector> outPositions, notnull array<vector> outDirections)
+    {
+        foreach (int id, SCR_TrafficToken token : m_mTokens)
+        {
+            outPositions.Insert(m_RoadIndex.GetPosition(token.m_iPoint));
+            outDirections.Insert(m_RoadIndex.GetDirection(token.m_iPoint) * token.m_iStep);
+        }
+    }
+
+    SCR_TrafficToken GetToken(int id)
+    {
+        return m_mTokens.Get(id);
+    }
+
+    // Hands the token over to the real-vehicle side: it stops existing here
+    void RemoveToken(int id)
+    {
+        SCR_TrafficToken token = m_mTokens.Get(id);
+        if (!token)
+            return;
+
+        m_Grid.RemoveFromCell(token.m_iCellKey, id);
+        m_mTokens.Remove(id);
+    }
+
+    // A despawned car continues virtually from the nearest road point towards its old destination
+    bool AddTokenAt(vector pos, vector destination)
+    {
+        if (!IsEnabled())
+            return false;
+
+        int pointId = m_RoadIndex.FindNearestPoint(pos, SNAP_RADIUS);
+        if (pointId == -1)
+            return false;
+
+        int destPoint = m_RoadIndex.FindNearestPoint(destination, SNAP_RADIUS);
+        if (destPoint != -1 && m_RoadIndex.GetComponent(destPoint) != m_RoadIndex.GetComponent(pointId))
+            destPoint = -1;
+
+        AddToken(pointId, destPoint);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected void AddToken(int pointId, int destPoint)
+    {
+        SCR_TrafficToken token = new SCR_TrafficToken();
+        token.m_iId = m_iNextId;
+        m_iNextId++;
+
+        token.m_iPoint = pointId;
+        token.m_iDestPoint = destPoint;
+        if (token.m_iDestPoint == -1)
+            token.m_iDestPoint = m_RoadIndex.PickDestination(pointId, MIN_DESTINATION_DISTANCE, PICK_ATTEMPTS);
+
+        if (token.m_iDestPoint == -1)
+            return;
+
+        token.m_iStep = ChooseStep(pointId, token.m_iDestPoint);
+
+        vector pos = m_RoadIndex.GetPosition(pointId);
+        token.m_iCellKey = m_Grid.GetKey(pos);
+        m_Grid.Insert(pos, token.m_iId);
+        m_mTokens.Insert(token.m_iId, token);
+    }
+
+    protected void Advance(SCR_TrafficToken token, float distance)
+    {
+        float spacing = SCR_TrafficRoadIndex.GetSampleSpacing();
+        token.m_fTravel += distance;
+
+        while (token.m_fTravel >= spacing)
+        {
+            token.m_fTravel -= spacing;
+
+            int next = m_RoadIndex.GetNextPointOnRoad(token.m_iPoint, token.m_iStep);
+            if (next == -1)
+                next = TakeJunction(token);
+
+            // Dead end: turn around
+            if (next == -1)
+            {
+                token.m_iStep *= -1;
+                continue;
+            }
+
+            token.m_iPoint = next;
+
+            if (vector.DistanceSqXZ(m_RoadIndex.GetPosition(next), m_RoadIndex.GetPosition(token.m_iDestPoint)) < ARRIVAL_RADIUS * ARRIVAL_RADIUS)
+            {
+                int newDest = m_RoadIndex.PickDestination(next, MIN_DESTINATION_DISTANCE, PICK_ATTEMPTS);
+                if (newDest != -1)
+                    token.m_iDestPoint = newDest;
+            }
+        }
+    }
+
+    // At the end of a road, continue on the connected road that heads closest to the destination.
+    // Updates the token's step for the new road and returns the point to move to, or -1.
+    protected int TakeJunction(SCR_TrafficToken token)
+    {
+        m_aJunctionBuffer.Clear();
+        m_RoadIndex.GetConnectedPoints(token.m_iPoint, m_aJunctionBuffer);
+
+        vector dest = m_RoadIndex.GetPosition(token.m_iDestPoint);
+        int best = -1;
+        int bestStep = 1;
+        float bestSq = float.MAX;
+
+        foreach (int candidate : m_aJunctionBuffer)
+        {
+            for (int step = -1; step <= 1; step += 2)
+            {
+                int ahead = m_RoadIndex.GetNextPointOnRoad(candidate, step);
+                if (ahead == -1)
+                    continue;
+
+                float distSq = vector.DistanceSqXZ(m_RoadIndex.GetPosition(ahead), dest);
+                if (distSq < bestSq)
+                {
+                    bestSq = distSq;
+                    best = candidate;
+                    bestStep = step;
+                }
+            }
+        }
+
+        if (best != -1)
+            token.m_iStep = bestStep;
+
+        return best;
+    }
+
+    // Direction along the current road that gets closer to the destination
+    protected int ChooseStep(int pointId, int destPoint)
+    {
+        vector dest = m_RoadIndex.GetPosition(destPoint);
+        int forward = m_RoadIndex.GetNextPointOnRoad(pointId, 1);
+        int backward = m_RoadIndex.GetNextPointOnRoad(pointId, -1);
+
+        if (forward == -1)
+            return -1;
+
+        if (backward == -1)
+            return 1;
+
+        if (vector.DistanceSqXZ(m_RoadIndex.GetPosition(backward), dest) < vector.DistanceSqXZ(m_RoadIndex.GetPosition(forward), dest))
+            return -1;
+
+        return 1;
+    }
+}
@@ -0,0 +1,181 @@
+// ------------------------------------------------------------------------------------------------
+// Answers "can any player see this car?" for despawn decisions at a fixed cost per tick.
+// Requests are queued and worked off round-robin with a trace budget; each result is cached on
+// the unit with a timestamp and reused until it expires. View cones compare against a cosine
+// threshold, and terrain height sampling along the sight line rejects hills and ridges before a
+// full physics trace is paid for.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficVisibilityService
+{
+    // cos(110 deg): half-angle of the view cone, generous to cover head turning
+    protected const float COS_VIEW_HALF_ANGLE = -0.342;
+    protected const float RESULT_TTL = 3.0;
+    protected const int TRACES_PER_TICK = 12;
+    protected const int MAX_TRACES_PER_VEHICLE = 4;
+    protected const int TERRAIN_SAMPLES = 8;
+    protected const float TERRAIN_MARGIN = 0.5;
+    protected const float TARGET_HEIGHT = 2.0;
+
+    protected float m_fRange = 3000.0;
+    protected ref array<SCR_TrafficUnit> m_aQueue = {};
+    protected ref array<int> m_aObserverBuffer = {};
+
+    // Counters
+    protected int m_iTracesLastTick;
+    protected int m_iTracesTotal;
+    protected int m_iTerrainOcclusionsTotal;
+
+    // ------------------------------------------------------------------------------------------------
+    // Players farther than this are never considered observers
+    void SetRange(float range)
+    {
+        m_fRange = range;
+    }
+
+    // Returns true with a cached result when one is fresh; otherwise queues a check and returns false.
+    // Callers should treat "no result yet" as visible.
+    bool GetVisibility(SCR_TrafficUnit unit, out bool visible)
+    {
+        if (unit.m_fVisibilityCheckedAt >= 0 && GetTime() - unit.m_fVisibilityCheckedAt < RESULT_TTL)
+        {
+            visible = unit.m_bVisible;
+            return true;
+        }
+
+        if (!unit.m_bVisibilityQueued)
+        {
+            unit.m_bVisibilityQueued = true;
+            m_aQueue.Insert(unit);
+        }
+
+        return false;
+    }
+
+    // Works off queued checks within the per-tick trace budget. A check is only started while the
+    // budget still covers its worst case, so the budget is never overrun.
+    void Process(SCR_TrafficPlayerSnapshot snapshot)
+    {
+        m_iTracesLastTick = 0;
+
+        while (!m_aQueue.IsEmpty() && m_iTracesLastTick + MAX_TRACES_PER_VEHICLE <= TRACES_PER_TICK)
+        {
+            SCR_TrafficUnit unit = m_aQueue[0];
+            m_aQueue.RemoveOrdered(0);
+
+            if (!unit)
+                continue;
+
+            unit.m_bVisibilityQueued = false;
+            if (!unit.m_Vehicle)
+                continue;
+
+            unit.m_bVisible = Evaluate(unit.m_Vehicle, snapshot);
+            unit.m_fVisibilityCheckedAt = GetTime();
+        }
+
+        m_iTracesTotal += m_iTracesLastTick;
+    }
+
+    void Clear()
+    {
+        m_aQueue.Clear();
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    int GetTracesLastTick()
+    {
+        return m_iTracesLastTick;
+    }
+
+    int GetTracesTotal()
+    {
+        return m_iTracesTotal;
+    }
+
+    int GetTerrainOcclusionsTotal()
+    {
+        return m_iTerrainOcclusionsTotal;
+    }
+
+    int GetQueueLength()
+    {
+        return m_aQueue.Count();
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected bool Evaluate(Vehicle veh, SCR_TrafficPlayerSnapshot snapshot)
+    {
+        vector target = veh.GetOrigin();
+        target[1] = target[1] + TARGET_HEIGHT;
+
+        m_aObserverBuffer.Clear();
+        snapshot.GetPlayersWithin(target, m_fRange, m_aObserverBuffer);
+
+        int traces;
+        foreach (int index : m_aObserverBuffer)
+        {
+            vector eyePos = snapshot.GetEyePosition(index);
+            vector toVehicle = target - eyePos;
+            float dist = toVehicle.Length();
+            if (dist < 1.0)
+                return true;
+
+            if (vector.Dot(snapshot.GetViewDirection(index), toVehicle * (1.0 / dist)) < COS_VIEW_HALF_ANGLE)
+                continue;
+
+            if (IsTerrainOccluded(eyePos, target))
+            {
+                m_iTerrainOcclusionsTotal++;
+                continue;
+            }
+
+            if (traces >= MAX_TRACES_PER_VEHICLE)
+                break;
+
+            traces++;
+            m_iTracesLastTick++;
+
+            if (HasLineOfSight(eyePos, target, veh))
+            {
+                Print(string.Format("[TRAFFIC DEBUG] Vehicle visible to player %1", snapshot.GetPlayerId(index)), LogLevel.DEBUG);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Samples the terrain under the sight line; ground above the line means a hill is in the way
+    protected bool IsTerrainOccluded(vector from, vector to)
+    {
+        BaseWorld world = GetGame().GetWorld();
+        float step = 1.0 / TERRAIN_SAMPLES;
+        for (int i = 1; i < TERRAIN_SAMPLES; i++)
+        {
+            vector p = vector.Lerp(from, to, i * step);
+            if (world.GetSurfaceY(p[0], p[2]) > p[1] + TERRAIN_MARGIN)
+                return true;
+        }
+
+        return false;
+    }
+
+    // The target itself is excluded, otherwise the trace always stops on the car it is looking for
+    protected bool HasLineOfSight(vector from, vector to, IEntity target)
+    {
+        autoptr TraceParam trace = new TraceParam();
+        trace.Start = from;
+        trace.End = to;
+        trace.Exclude = target;
+        trace.Flags = TraceFlags.WORLD | TraceFlags.ENTS;
+        trace.LayerMask = EPhysicsLayerPresets.Projectile;
+
+        float hitDist = GetGame().GetWorld().TraceMove(trace, null);
+        return hitDist >= 1.0;
+    }
+
+    protected float GetTime()
+    {
+        return GetGame().GetWorld().GetWorldTime() / 1000.0;
+    }
+}
@@ -0,0 +1,246 @@
+// ------------------------------------------------------------------------------------------------
+// Move waypoints owned by the traffic system. Orders reuse a free waypoint entity (moved to the
+// new position and re-added to the group) and only spawn one when the free list is empty.
+// Handed-out waypoints are swept every tick: once their group has completed or dropped them they
+// go back to the free list, so the number of waypoint entities stays flat over a session.
+// ------------------------------------------------------------------------------------------------
+class SCR_TrafficWaypointPool
+{
+    protected const int MAX_FREE = 64;
+
+    protected ResourceName m_WaypointPrefab;
+    protected SCR_TrafficResourceCache m_ResourceCache;
+    // Waypoints are spawned without replication; clients never see them, Game Master included
+    protected bool m_bLocal;
+
+    protected ref array<AIWaypoint> m_aFree = {};
+    protected ref array<AIWaypoint> m_aAssigned = {};
+    protected ref array<SCR_AIGroup> m_aAssignedGroups = {};
+    protected ref array<AIWaypoint> m_aGroupBuffer = {};
+
+    // Completion settings of a freshly spawned waypoint; callers such as the flee path change
+    // them, so every waypoint is reset to these when it is handed out or returned
+    protected bool m_bDefaultsKnown;
+    protected EAIWaypointCompletionType m_eDefaultCompletionType;
+    protected float m_fDefaultCompletionRadius;
+
+    // Lifetime counters
+    protected int m_iSpawnedTotal;
+    protected int m_iReusedTotal;
+
+    // ------------------------------------------------------------------------------------------------
+    void SCR_TrafficWaypointPool(SCR_TrafficResourceCache resourceCache, ResourceName waypointPrefab)
+    {
+        m_ResourceCache = resourceCache;
+        m_WaypointPrefab = waypointPrefab;
+    }
+
+    void SetLocal(bool local)
+    {
+        m_bLocal = local;
+    }
+
+    // Waypoint entities currently alive, assigned or free
+    int GetLiveCount()
+    {
+        return m_aAssigned.Count() + m_aFree.Count();
+    }
+
+    int GetFreeCount()
+    {
+        return m_aFree.Count();
+    }
+
+    int GetSpawnedTotal()
+    {
+        return m_iSpawnedTotal;
+    }
+
+    int GetReusedTotal()
+    {
+        return m_iReusedTotal;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Places a waypoint at pos and adds it to the group. Returns null if none could be spawned.
+    AIWaypoint Assign(SCR_AIGroup group, vector pos, float completionRadius)
+    {
+        AIWaypoint wp = TakeFree();
+        if (wp)
+        {
+            wp.SetOrigin(pos);
+            m_iReusedTotal++;
+        }
+        else
+        {
+            EntitySpawnParams params = new EntitySpawnParams();
+            params.Transform[3] = pos;
+
+            IEntity wpEnt;
+            if (m_bLocal)
+                wpEnt = GetGame().SpawnEntityPrefabLocal(m_ResourceCache.Get(m_WaypointPrefab), GetGame().GetWorld(), params);
+            else
+                wpEnt = GetGame().SpawnEntityPrefab(m_ResourceCache.Get(m_WaypointPrefab), GetGame().GetWorld(), params);
+
+            wp = AIWaypoint.Cast(wpEnt);
+            if (!wp)
+                return null;
+
+            m_iSpawnedTotal++;
+            CaptureDefaults(wp);
+        }
+
+        ResetCompletion(wp);
+        wp.SetCompletionRadius(completionRadius);
+        group.AddWaypoint(wp);
+        SetEditableParent(wp, group);
+
+        m_aAssigned.Insert(wp);
+        m_aAssignedGroups.Insert(group);
+        return wp;
+    }
+
+    // Removes every waypoint from the group. Pool waypoints are returned; any others belong to
+    // whoever placed them (e.g. a mission's civilian) and are only detached, never deleted.
+    void ClearGroup(SCR_AIGroup group)
+    {
+        if (!group)
+            return;
+
+        m_aGroupBuffer.Clear();
+        group.GetWaypoints(m_aGroupBuffer);
+        foreach (AIWaypoint wp : m_aGroupBuffer)
+        {
+            group.RemoveWaypoint(wp);
+
+            int index = m_aAssigned.Find(wp);
+            if (index == -1)
+                continue;
+
+            m_aAssigned.Remove(index);
+            m_aAssignedGroups.Remove(index);
+            Release(wp);
+        }
+    }
+
+    // Returns waypoints whose group completed or dropped them
+    void Sweep()
+    {
+        for (int i = m_aAssigned.Count() - 1; i >= 0; i--)
+        {
+            AIWaypoint wp = m_aAssigned[i];
+            SCR_AIGroup group = m_aAssignedGroups[i];
+
+            // Deleted by someone else: nothing to reclaim
+            if (!wp)
+            {
+                m_aAssigned.Remove(i);
+                m_aAssignedGroups.Remove(i);
+                continue;
+            }
+
+            if (group)
+            {
+                m_aGroupBuffer.Clear();
+                group.GetWaypoints(m_aGroupBuffer);
+                if (m_aGroupBuffer.Contains(wp))
+                    continue;
+            }
+
+            m_aAssigned.Remove(i);
+            m_aAssignedGroups.Remove(i);
+            Release(wp);
+        }
+    }
+
+    void Clear()
+    {
+        foreach (AIWaypoint wp : m_aAssigned)
+        {
+            if (wp)
+                SCR_EntityHelper.DeleteEntityAndChildren(wp);
+        }
+
+        foreach (AIWaypoint wp : m_aFree)
+        {
+            if (wp)
+                SCR_EntityHelper.DeleteEntityAndChildren(wp);
+        }
+
+        m_aAssigned.Clear();
+        m_aAssignedGroups.Clear();
+        m_aFree.Clear();
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    protected AIWaypoint TakeFree()
+    {
+        while (!m_aFree.IsEmpty())
+        {
+            int last = m_aFree.Count() - 1;
+            AIWaypoint wp = m_aFree[last];
+            m_aFree.Remove(last);
+
+            if (wp)
+                return wp;
+        }
+
+        return null;
+    }
+
+    protected void Release(AIWaypoint wp)
+    {
+        if (m_aFree.Count() >= MAX_FREE)
+        {
+            SCR_EntityHelper.DeleteEntityAndChildren(wp);
+            return;
+        }
+
+        ResetCompletion(wp);
+        SetEditableParent(wp, null);
+        m_aFree.Insert(wp);
+    }
+
+    protected void CaptureDefaults(AIWaypoint wp)
+    {
+        if (m_bDefaultsKnown)
+            return;
+
+        SCR_AIWaypoint scrWp = SCR_AIWaypoint.Cast(wp);
+        if (scrWp)
+            m_eDefaultCompletionType = scrWp.GetCompletionType();
+
+        m_fDefaultCompletionRadius = wp.GetCompletionRadius();
+        m_bDefaultsKnown = true;
+    }
+
+    protected void ResetCompletion(AIWaypoint wp)
+    {
+        if (!m_bDefaultsKnown)
+            return;
+
+        SCR_AIWaypoint scrWp = SCR_AIWaypoint.Cast(wp);
+        if (scrWp)
+            scrWp.SetCompletionType(m_eDefaultCompletionType);
+
+        wp.SetCompletionRadius(m_fDefaultCompletionRadius);
+    }
+
+    // Keeps Game Master's view of the waypoint attached to the group that follows it
+    protected void SetEditableParent(AIWaypoint wp, SCR_AIGroup group)
+    {
+        // A local waypoint has no Game Master representation to attach
+        if (m_bLocal)
+            return;
+
+        SCR_EditableEntityComponent wpEditable = SCR_EditableEntityComponent.Cast(wp.FindComponent(SCR_EditableEntityComponent));
+        if (!wpEditable)
+            return;
+
+        SCR_EditableEntityComponent groupEditable;
+        if (group)
+            groupEditable = SCR_EditableEntityComponent.Cast(group.FindComponent(SCR_EditableEntityComponent));
+
+        wpEditable.SetParentEntity(groupEditable);
+    }
+}